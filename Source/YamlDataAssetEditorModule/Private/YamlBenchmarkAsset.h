@@ -0,0 +1,71 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "YamlBenchmarkAsset.generated.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// types the synthetic benchmark files are imported into (hidden from the class picker, the files
+// name the asset class with __uclass)
+
+USTRUCT()
+struct FYamlBenchmarkNode
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FName Name;
+
+    UPROPERTY()
+    int32 Value = 0;
+
+    UPROPERTY()
+    TArray<FYamlBenchmarkNode> Children;
+};
+
+USTRUCT()
+struct FYamlBenchmarkItem
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FName Name;
+
+    UPROPERTY()
+    int32 Count = 0;
+
+    UPROPERTY()
+    float Weight = 0.0f;
+
+    UPROPERTY()
+    TArray<int32> Values;
+};
+
+UCLASS( Transient, HideDropdown )
+class UYamlBenchmarkAsset : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    TMap<FString, int32> Wide;
+
+    UPROPERTY()
+    FYamlBenchmarkNode Deep;
+
+    UPROPERTY()
+    TArray<int32> Integers;
+
+    UPROPERTY()
+    TArray<float> Floats;
+
+    UPROPERTY()
+    TArray<FString> Strings;
+
+    UPROPERTY()
+    TArray<FYamlBenchmarkItem> Items;
+};
@@ -0,0 +1,462 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlBenchmarkCommandlet.h"
+#include "YamlBenchmarkAsset.h"
+#include "YamlDataAssetEditorModule.h"
+#include "YamlExporter.h"
+#include "YamlFileBuffer.h"
+#include "YamlImportFactory.h"
+#include "YamlImportUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+#include "yaml-cpp/include/eventhandler.h"
+#include "yaml-cpp/include/yaml.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// count the nodes in a document without building anything
+
+class FYamlCountingHandler : public YAML::EventHandler
+{
+public:
+
+    int64 Nodes = 0;
+
+    virtual void OnDocumentStart( const YAML::Mark& Mark ) override {}
+    virtual void OnDocumentEnd() override {}
+
+    virtual void OnNull( const YAML::Mark& Mark, YAML::anchor_t Anchor ) override { ++Nodes; }
+    virtual void OnAlias( const YAML::Mark& Mark, YAML::anchor_t Anchor ) override { ++Nodes; }
+    virtual void OnScalar( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, const std::string& Value ) override { ++Nodes; }
+    virtual void OnScalarView( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, std::string_view Value ) override { ++Nodes; }
+
+    virtual void OnSequenceStart( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, YAML::EmitterStyle::value Style ) override { ++Nodes; }
+    virtual void OnSequenceEnd() override {}
+
+    virtual void OnMapStart( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, YAML::EmitterStyle::value Style ) override { ++Nodes; }
+    virtual void OnMapEnd() override {}
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// collect the exported text
+
+class FYamlStringOutput : public FOutputDevice
+{
+public:
+
+    FString Text;
+
+    virtual void Serialize( const TCHAR* Value, ELogVerbosity::Type Verbosity, const FName& Category ) override
+    {
+        Text += Value;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// synthetic corpora, sizes are multiplied by -scale
+
+static FString MakeWideMap( int32 Scale )
+{
+    FString Yaml = TEXT( "__uclass: YamlBenchmarkAsset\nWide:\n" );
+
+    for( int32 Index = 0; Index < 20000 * Scale; ++Index )
+    {
+        Yaml.Appendf( TEXT( "  Key%d: %d\n" ), Index, Index * 7 );
+    }
+
+    return Yaml;
+}
+
+static void AppendDeepNode( FString& Yaml, int32 Depth, int32 MaxDepth, int32 Leaves )
+{
+    const auto Pad = FString::ChrN( Depth * 4 + 2, TEXT( ' ' ) );
+
+    Yaml.Appendf( TEXT( "%sName: Node%d\n%sValue: %d\n" ), *Pad, Depth, *Pad, Depth );
+
+    if( Depth == MaxDepth )
+    {
+        return;
+    }
+
+    Yaml.Appendf( TEXT( "%sChildren:\n" ), *Pad );
+
+    for( int32 Index = 0; Index < Leaves; ++Index )
+    {
+        Yaml.Appendf( TEXT( "%s  - { Name: Leaf%d, Value: %d }\n" ), *Pad, Index, Depth * Leaves + Index );
+    }
+
+    Yaml.Appendf( TEXT( "%s  -\n" ), *Pad );
+    AppendDeepNode( Yaml, Depth + 1, MaxDepth, Leaves );
+}
+
+static FString MakeDeepNesting( int32 Scale )
+{
+    FString Yaml = TEXT( "__uclass: YamlBenchmarkAsset\nDeep:\n" );
+    AppendDeepNode( Yaml, 0, 64, 16 * Scale );
+    return Yaml;
+}
+
+static FString MakeNumericArrays( int32 Scale )
+{
+    FRandomStream Random( 42 );
+    const int32 Count = 100000 * Scale;
+
+    // integers as a flow sequence, floats as a block sequence
+
+    FString Yaml = TEXT( "__uclass: YamlBenchmarkAsset\nIntegers: [" );
+
+    for( int32 Index = 0; Index < Count; ++Index )
+    {
+        if( Index % 16 )
+        {
+            Yaml.Appendf( TEXT( " %d," ), Random.RandRange( -1000000, 1000000 ) );
+        }
+        else
+        {
+            Yaml.Appendf( TEXT( "\n  %d," ), Random.RandRange( -1000000, 1000000 ) );
+        }
+    }
+
+    Yaml.RemoveFromEnd( TEXT( "," ) );
+    Yaml += TEXT( " ]\nFloats:\n" );
+
+    for( int32 Index = 0; Index < Count; ++Index )
+    {
+        Yaml.Appendf( TEXT( "  - %.6f\n" ), Random.FRandRange( -1000.0f, 1000.0f ) );
+    }
+
+    return Yaml;
+}
+
+static FString MakeLongStrings( int32 Scale )
+{
+    static const TCHAR* Words[] = { TEXT( "lorem" ), TEXT( "ipsum" ), TEXT( "dolor" ), TEXT( "sit" ), TEXT( "amet" ), TEXT( "consectetur" ), TEXT( "adipiscing" ), TEXT( "elit" ) };
+
+    FRandomStream Random( 42 );
+
+    auto MakeLine = [&]( int32 Length )
+    {
+        FString Line;
+
+        while( Line.Len() < Length )
+        {
+            Line += Words[ Random.RandHelper( (int32) UE_ARRAY_COUNT( Words ) ) ];
+            Line += TEXT( ' ' );
+        }
+
+        return Line.TrimEnd();
+    };
+
+    // alternate plain, double quoted (with escapes) and literal block scalars
+
+    FString Yaml = TEXT( "__uclass: YamlBenchmarkAsset\nStrings:\n" );
+
+    for( int32 Index = 0; Index < 2000 * Scale; ++Index )
+    {
+        switch( Index % 3 )
+        {
+            case 0:
+                Yaml.Appendf( TEXT( "  - %s\n" ), *MakeLine( 1024 ) );
+                break;
+
+            case 1:
+                Yaml.Appendf( TEXT( "  - \"%s\\t\\\"%s\\\"\\n%s\"\n" ), *MakeLine( 256 ), *MakeLine( 256 ), *MakeLine( 512 ) );
+                break;
+
+            default:
+                Yaml += TEXT( "  - |\n" );
+
+                for( int32 Line = 0; Line < 8; ++Line )
+                {
+                    Yaml.Appendf( TEXT( "    %s\n" ), *MakeLine( 128 ) );
+                }
+                break;
+        }
+    }
+
+    return Yaml;
+}
+
+static FString MakeAnchors( int32 Scale )
+{
+    const int32 Anchors = 2000 * Scale;
+
+    FString Yaml = TEXT( "__uclass: YamlBenchmarkAsset\nItems:\n" );
+
+    for( int32 Index = 0; Index < Anchors; ++Index )
+    {
+        Yaml.Appendf( TEXT( "  - &Item%d { Name: Item%d, Count: %d, Weight: %.3f, Values: [ 1, 2, 3, 4, 5, 6, 7, 8 ] }\n" ), Index, Index, Index * 3, Index * 0.25f );
+    }
+
+    for( int32 Index = 0; Index < 20000 * Scale; ++Index )
+    {
+        Yaml.Appendf( TEXT( "  - *Item%d\n" ), Index % Anchors );
+    }
+
+    return Yaml;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// timings for one stage of one corpus
+
+struct FYamlBenchmarkResult
+{
+    FString Corpus;
+    FString Stage;
+    int64   Bytes       = 0;
+    int64   Nodes       = 0;
+    double  Best        = 0.0;  // seconds
+    double  Mean        = 0.0;
+    int64   Memory      = 0;    // growth in used physical memory over the stage (bytes)
+    bool    bOk         = true;
+};
+
+static FYamlBenchmarkResult Measure( const FString& Corpus, const TCHAR* Stage, int32 Iterations, int64 Bytes, int64 Nodes, TFunctionRef<bool()> Body )
+{
+    FYamlBenchmarkResult Result;
+    Result.Corpus = Corpus;
+    Result.Stage  = Stage;
+    Result.Bytes  = Bytes;
+    Result.Nodes  = Nodes;
+    Result.Best   = DBL_MAX;
+
+    double Total = 0.0;
+
+    // the platform's view of the process, so anything else allocating at the same time is included
+    // (use -trace=memalloc with Unreal Insights for a breakdown)
+
+    const int64 UsedBefore = (int64) FPlatformMemory::GetStats().UsedPhysical;
+
+    for( int32 Iteration = 0; Iteration < Iterations && Result.bOk; ++Iteration )
+    {
+        const double Start = FPlatformTime::Seconds();
+        Result.bOk = Body();
+        const double Time = FPlatformTime::Seconds() - Start;
+
+        Result.Best = FMath::Min( Result.Best, Time );
+        Total      += Time;
+    }
+
+    Result.Mean   = Total / Iterations;
+    Result.Memory = (int64) FPlatformMemory::GetStats().UsedPhysical - UsedBefore;
+
+    // don't let the garbage from one stage land in the next
+
+    CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS );
+
+    return Result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+UYamlBenchmarkCommandlet::UYamlBenchmarkCommandlet( const FObjectInitializer& ObjectInitializer )
+    : Super( ObjectInitializer )
+{
+    IsClient        = false;
+    IsServer        = false;
+    IsEditor        = true;
+    LogToConsole    = true;
+    HelpDescription = TEXT( "Benchmark the yaml import and export on synthetic files" );
+    HelpUsage       = TEXT( "-run=YamlBenchmark [-iterations=5] [-scale=1] [-csv=<file>]" );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+int32 UYamlBenchmarkCommandlet::Main( const FString& Params )
+{
+    int32   Iterations = 5;
+    int32   Scale      = 1;
+    FString CsvFile;
+
+    FParse::Value( *Params, TEXT( "iterations=" ), Iterations );
+    FParse::Value( *Params, TEXT( "scale=" ), Scale );
+    FParse::Value( *Params, TEXT( "csv=" ), CsvFile );
+
+    Iterations = FMath::Max( Iterations, 1 );
+    Scale      = FMath::Max( Scale, 1 );
+
+    auto StreamingImport = IConsoleManager::Get().FindConsoleVariable( TEXT( "YamlDataAsset.StreamingImport" ) );
+    const bool bStreamingImport = StreamingImport->GetBool();
+
+    // write the corpora out so the imports go through the same file path as the editor
+
+    const TPair<const TCHAR*, FString( * )( int32 )> Corpora[] =
+    {
+        { TEXT( "WideMap" ),        &MakeWideMap },
+        { TEXT( "DeepNesting" ),    &MakeDeepNesting },
+        { TEXT( "NumericArrays" ),  &MakeNumericArrays },
+        { TEXT( "LongStrings" ),    &MakeLongStrings },
+        { TEXT( "Anchors" ),        &MakeAnchors },
+    };
+
+    const auto Folder = FPaths::Combine( FPaths::ProjectIntermediateDir(), TEXT( "YamlBenchmark" ) );
+
+    TArray<FYamlBenchmarkResult> Results;
+
+    for( const auto& Corpus : Corpora )
+    {
+        const auto Name     = FString( Corpus.Key );
+        const auto Filename = FPaths::Combine( Folder, Name + TEXT( ".yaml" ) );
+
+        if( !FFileHelper::SaveStringToFile( Corpus.Value( Scale ), *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to write %s" ), *Filename );
+            return 1;
+        }
+
+        FYamlFileBuffer Buffer;
+
+        if( !Buffer.Load( Filename ) )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s" ), *Filename );
+            return 1;
+        }
+
+        const int64 Bytes = (int64) Buffer.Num();
+
+        // count the nodes once up front for nodes/s
+
+        FYamlCountingHandler Counter;
+
+        try
+        {
+            YAML::Parser Parser( Buffer.GetData(), Buffer.Num() );
+            Parser.HandleNextDocument( Counter );
+        }
+        catch( const YAML::Exception& Exception )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to parse %s - %s" ), *Filename, *DescribeError( Exception ) );
+            return 1;
+        }
+
+        const int64 Nodes = Counter.Nodes;
+
+        // yaml-cpp on its own
+
+        Results.Add( Measure( Name, TEXT( "Events" ), Iterations, Bytes, Nodes, [&]()
+        {
+            FYamlCountingHandler Handler;
+            YAML::Parser Parser( Buffer.GetData(), Buffer.Num() );
+            return Parser.HandleNextDocument( Handler );
+        }));
+
+        Results.Add( Measure( Name, TEXT( "Load" ), Iterations, Bytes, Nodes, [&]()
+        {
+            return YAML::Load( Buffer.GetData(), Buffer.Num() ).IsMap();
+        }));
+
+        // imports through the factory (file to asset)
+
+        TStrongObjectPtr<UObject> Imported;
+
+        auto Import = [&]( bool bStreaming )
+        {
+            StreamingImport->Set( bStreaming, ECVF_SetByCode );
+
+            return Measure( Name, bStreaming ? TEXT( "Import" ) : TEXT( "ImportTree" ), Iterations, Bytes, Nodes, [&]()
+            {
+                auto Factory  = NewObject<UYamlImportFactory>();
+                auto Package  = GetTransientPackage();
+                bool bCancel  = false;
+
+                auto Asset = Factory->FactoryCreateFile( UYamlBenchmarkAsset::StaticClass(), Package, MakeUniqueObjectName( Package, UYamlBenchmarkAsset::StaticClass() ), RF_Transient, Filename, nullptr, GWarn, bCancel );
+
+                if( !Asset )
+                {
+                    return false;
+                }
+
+                if( !Imported )
+                {
+                    Imported.Reset( Asset );
+                }
+                else
+                {
+                    Asset->MarkAsGarbage();
+                }
+
+                return true;
+            });
+        };
+
+        Results.Add( Import( true ) );
+        Results.Add( Import( false ) );
+
+        StreamingImport->Set( bStreamingImport, ECVF_SetByCode );
+
+        // export the imported asset back to text
+
+        if( Imported )
+        {
+            auto Exporter = TStrongObjectPtr<UYamlExporter>( NewObject<UYamlExporter>() );
+
+            FYamlStringOutput Sizing;
+            Exporter->ExportText( nullptr, Imported.Get(), TEXT( "yaml" ), Sizing, GWarn );
+
+            Results.Add( Measure( Name, TEXT( "Export" ), Iterations, Sizing.Text.Len(), Nodes, [&]()
+            {
+                FYamlStringOutput Output;
+                return Exporter->ExportText( nullptr, Imported.Get(), TEXT( "yaml" ), Output, GWarn );
+            }));
+        }
+    }
+
+    // report
+
+    const double MB = 1024.0 * 1024.0;
+
+    FString Csv = TEXT( "Corpus,Stage,Bytes,Nodes,BestMs,MeanMs,MBps,NodesPerSec,MemoryBytes\n" );
+
+    UE_LOG( LogYamlDataAsset, Display, TEXT( "%-14s %-10s %9s %9s %9s %9s %9s %12s %10s" ),
+        TEXT( "Corpus" ), TEXT( "Stage" ), TEXT( "Size(MB)" ), TEXT( "Nodes" ), TEXT( "Best(ms)" ), TEXT( "Mean(ms)" ), TEXT( "MB/s" ), TEXT( "Nodes/s" ), TEXT( "Memory(MB)" ) );
+
+    bool bFailed = false;
+
+    for( const auto& Result : Results )
+    {
+        if( !Result.bOk )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "%-14s %-10s failed" ), *Result.Corpus, *Result.Stage );
+            bFailed = true;
+            continue;
+        }
+
+        const double MBps     = Result.Bytes / MB / Result.Best;
+        const double NodesPS  = Result.Nodes / Result.Best;
+
+        UE_LOG( LogYamlDataAsset, Display, TEXT( "%-14s %-10s %9.2f %9lld %9.2f %9.2f %9.1f %12.0f %10.1f" ),
+            *Result.Corpus,
+            *Result.Stage,
+            Result.Bytes / MB,
+            Result.Nodes,
+            Result.Best * 1000.0,
+            Result.Mean * 1000.0,
+            MBps,
+            NodesPS,
+            Result.Memory / MB
+        );
+
+        Csv.Appendf( TEXT( "%s,%s,%lld,%lld,%.3f,%.3f,%.3f,%.0f,%lld\n" ),
+            *Result.Corpus, *Result.Stage, Result.Bytes, Result.Nodes, Result.Best * 1000.0, Result.Mean * 1000.0, MBps, NodesPS, Result.Memory );
+    }
+
+    // the peak only ever goes up, so it's for the whole run rather than any one stage
+
+    UE_LOG( LogYamlDataAsset, Display, TEXT( "Process peak physical memory %.1f MB" ), FPlatformMemory::GetStats().PeakUsedPhysical / MB );
+
+    if( !CsvFile.IsEmpty() && !FFileHelper::SaveStringToFile( Csv, *CsvFile ) )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to write %s" ), *CsvFile );
+        bFailed = true;
+    }
+
+    return bFailed ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlClassRegistry.h"
+#include "Engine/DataAsset.h"
+#include "UObject/UObjectHash.h"
+
+
+//-------------------------------------------------------------------------------------------------
+
+static TArray<UClass*>      Classes;        // for the class picker, sorted by name
+static TMap<FName, UClass*> ClassesByName;
+static bool                 bBuilt = false;
+
+static bool IsImportable( const UClass* Class )
+{
+    if( !Class->IsNative() )
+    {
+        return false;
+    }
+
+    if( Class->HasAnyClassFlags( CLASS_Deprecated | CLASS_NewerVersionExists ) )
+    {
+        return false;
+    }
+
+    return Class->IsChildOf( UDataAsset::StaticClass() ) && Class != UDataAsset::StaticClass();
+}
+
+static void AddClass( UClass* Class )
+{
+    if( !IsImportable( Class ) || ClassesByName.Contains( Class->GetFName() ) )
+    {
+        return;
+    }
+
+    ClassesByName.Add( Class->GetFName(), Class );
+
+    // hidden classes can still be named by __uclass, they just aren't offered in the picker
+
+    if( !Class->HasAnyClassFlags( CLASS_HideDropDown ) )
+    {
+        Classes.Add( Class );
+    }
+}
+
+static void SortClasses()
+{
+    Classes.Sort( []( UClass& A, UClass& B ) { return A.GetFName().Compare( B.GetFName() ) < 0; } );
+}
+
+static void Build()
+{
+    if( bBuilt )
+    {
+        return;
+    }
+
+    bBuilt = true;
+
+    for( TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt )
+    {
+        AddClass( *ClassIt );
+    }
+
+    SortClasses();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+UClass* FYamlClassRegistry::Find( FName ClassName )
+{
+    if( ClassName.IsNone() )
+    {
+        return nullptr;
+    }
+
+    Build();
+
+    return ClassesByName.FindRef( ClassName );
+}
+
+const TArray<UClass*>& FYamlClassRegistry::GetClasses()
+{
+    Build();
+
+    return Classes;
+}
+
+void FYamlClassRegistry::AddModule( FName ModuleName )
+{
+    // nothing to add to until it has been built
+
+    if( !bBuilt )
+    {
+        return;
+    }
+
+    // native classes live in the module's script package
+
+    auto Package = FindPackage( nullptr, *( TEXT( "/Script/" ) + ModuleName.ToString() ) );
+
+    if( !Package )
+    {
+        return;
+    }
+
+    const int32 Num = ClassesByName.Num();
+
+    ForEachObjectWithPackage( Package, []( UObject* Object )
+    {
+        if( auto Class = Cast<UClass>( Object ) )
+        {
+            AddClass( Class );
+        }
+
+        return true;
+    }, false );
+
+    if( ClassesByName.Num() != Num )
+    {
+        SortClasses();
+    }
+}
+
+void FYamlClassRegistry::Invalidate()
+{
+    Classes.Empty();
+    ClassesByName.Empty();
+    bBuilt = false;
+}
@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// The native UDataAsset classes that can be imported, by name
+//
+// Built the first time it is needed rather than scanning every UClass per import. Classes from
+// modules loaded afterwards are added as they come in, unloading a module or a hot reload or live
+// coding patch removes or replaces classes so the whole thing is rebuilt. Game thread only.
+//
+
+class FYamlClassRegistry
+{
+public:
+
+    // the class for a __uclass name (nullptr if it isn't an importable data asset)
+    static UClass* Find( FName ClassName );
+
+    // the classes to offer when the file doesn't say, sorted by name (excludes HideDropdown classes)
+    static const TArray<UClass*>& GetClasses();
+
+    // add the classes from a newly loaded module
+    static void AddModule( FName ModuleName );
+
+    // rebuild on next use (e.g. after a hot reload or a module is unloaded)
+    static void Invalidate();
+};
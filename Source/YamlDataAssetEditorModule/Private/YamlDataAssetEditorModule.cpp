@@ -1,17 +1,159 @@
 // Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
 
 #include "YamlDataAssetEditorModule.h"
+#include "YamlClassRegistry.h"
+#include "YamlExportPlan.h"
+#include "YamlImportCache.h"
+#include "YamlImportFactory.h"
+#include "YamlImportPipeline.h"
+#include "YamlImportPlan.h"
+#include "DesktopPlatformModule.h"
+#include "EditorDirectories.h"
+#include "Framework/Application/SlateApplication.h"
+#include "IContentBrowserSingleton.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ToolMenus.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
 
 DEFINE_LOG_CATEGORY( LogYamlDataAsset );
 
 #define LOCTEXT_NAMESPACE "FYamlAssetImporterEditor"
 
+
+//-------------------------------------------------------------------------------------------------
+// import a set of files into the current content browser folder, parsing them in parallel
+
+static void ImportYamlFiles()
+{
+    auto DesktopPlatform = FDesktopPlatformModule::Get();
+
+    if( !DesktopPlatform )
+    {
+        return;
+    }
+
+    TArray<FString> Files;
+
+    const bool bOpened = DesktopPlatform->OpenFileDialog(
+        FSlateApplication::Get().FindBestParentWindowHandleForDialogs( nullptr ),
+        LOCTEXT( "ImportYamlFilesTitle", "Import YAML Files" ).ToString(),
+        FEditorDirectories::Get().GetLastDirectory( ELastDirectory::GENERIC_IMPORT ),
+        TEXT( "" ),
+        TEXT( "YAML files (*.yaml)|*.yaml" ),
+        EFileDialogFlags::Multiple,
+        Files
+    );
+
+    if( !bOpened || Files.IsEmpty() )
+    {
+        return;
+    }
+
+    FEditorDirectories::Get().SetLastDirectory( ELastDirectory::GENERIC_IMPORT, FPaths::GetPath( Files[ 0 ] ) );
+
+    auto Dest = IContentBrowserSingleton::Get().GetCurrentPath().GetInternalPathString();
+
+    if( Dest.IsEmpty() )
+    {
+        Dest = TEXT( "/Game" );
+    }
+
+    // parse on worker threads, create the assets here
+
+    FScopedSlowTask SlowTask( Files.Num(), LOCTEXT( "ImportingYamlFiles", "Importing YAML files..." ) );
+    SlowTask.MakeDialog( true );
+
+    TStrongObjectPtr<UYamlImportFactory> Factory( NewObject<UYamlImportFactory>() );
+    TArray<UObject*> Imported;
+
+    FYamlImportPipeline::Run( Files, [&]( int32 Index, const FYamlImportPipeline::FFile& File )
+    {
+        const auto& Filename = Files[ Index ];
+
+        SlowTask.EnterProgressFrame( 1, FText::FromString( FPaths::GetCleanFilename( Filename ) ) );
+
+        if( SlowTask.ShouldCancel() )
+        {
+            return false;
+        }
+
+        FYamlImportPipeline::ImportToPackage( Factory.Get(), File, Dest / FPaths::GetBaseFilename( Filename ), Filename, Imported );
+
+        return true;
+    });
+
+    IContentBrowserSingleton::Get().SyncBrowserToAssets( Imported );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+void FYamlDataAssetEditorModule::RegisterMenus()
+{
+    FToolMenuOwnerScoped OwnerScoped( this );
+
+    auto Menu = UToolMenus::Get()->ExtendMenu( "ContentBrowser.AddNewContextMenu" );
+    auto& Section = Menu->FindOrAddSection( "ContentBrowserImportAsset" );
+
+    Section.AddMenuEntry(
+        "ImportYamlFiles",
+        LOCTEXT( "ImportYamlFiles", "Import YAML Files..." ),
+        LOCTEXT( "ImportYamlFilesTooltip", "Import several YAML files into this folder at once (the files are parsed in parallel)" ),
+        FSlateIcon( FAppStyle::GetAppStyleSetName(), "Icons.Import" ),
+        FUIAction( FExecuteAction::CreateStatic( &ImportYamlFiles ) )
+    );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
 void FYamlDataAssetEditorModule::StartupModule()
 {
+    // cached import and export plans point at native properties, so rebuild them after a hot reload or live coding patch
+
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda( []( EReloadCompleteReason )
+    {
+        FYamlImportPlan::Invalidate();
+        FYamlExportPlan::Invalidate();
+        FYamlClassRegistry::Invalidate();
+    });
+
+    // let the asset registry see the source hashes, for skipping unchanged files without loading the assets
+
+    FYamlImportCache::RegisterTags();
+
+    // pick up data asset classes from modules loaded later on, and drop them (and any plans for their
+    // properties) when they go away
+
+    ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda( []( FName ModuleName, EModuleChangeReason Reason )
+    {
+        if( Reason == EModuleChangeReason::ModuleLoaded )
+        {
+            FYamlClassRegistry::AddModule( ModuleName );
+        }
+        else if( Reason == EModuleChangeReason::ModuleUnloaded )
+        {
+            FYamlImportPlan::Invalidate();
+            FYamlExportPlan::Invalidate();
+            FYamlClassRegistry::Invalidate();
+        }
+    });
+
+    UToolMenus::RegisterStartupCallback( FSimpleMulticastDelegate::FDelegate::CreateRaw( this, &FYamlDataAssetEditorModule::RegisterMenus ) );
 }
 
 void FYamlDataAssetEditorModule::ShutdownModule()
 {
+    UToolMenus::UnRegisterStartupCallback( this );
+    UToolMenus::UnregisterOwner( this );
+
+    FModuleManager::Get().OnModulesChanged().Remove( ModulesChangedHandle );
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove( ReloadCompleteHandle );
+    FYamlImportCache::UnregisterTags();
+    FYamlImportPlan::Invalidate();
+    FYamlExportPlan::Invalidate();
+    FYamlClassRegistry::Invalidate();
 }
 
 #undef LOCTEXT_NAMESPACE
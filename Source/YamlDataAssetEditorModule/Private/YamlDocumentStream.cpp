@@ -0,0 +1,80 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlDocumentStream.h"
+#include "YamlImportUtils.h"
+#include "yaml-cpp/src/nodebuilder.h"
+
+
+//-------------------------------------------------------------------------------------------------
+
+FYamlDocumentStream::FYamlDocumentStream( const char* Data, std::size_t Size )
+    : Parser( Data, Size )
+{
+    Prefetch();
+}
+
+FYamlDocumentStream::~FYamlDocumentStream()
+{
+    // the worker is using the parser
+
+    if( Pending.IsValid() )
+    {
+        Pending.Wait();
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+void FYamlDocumentStream::Prefetch()
+{
+    Pending = UE::Tasks::Launch( UE_SOURCE_LOCATION, [this]()
+    {
+        FResult Result;
+
+        try
+        {
+            // as YAML::LoadAll, an empty document ends the stream
+
+            YAML::NodeBuilder Builder;
+
+            if( Parser.HandleNextDocument( Builder ) && !Builder.Root().IsNull() )
+            {
+                Result.Doc    = Builder.Root();
+                Result.bFound = true;
+            }
+        }
+        catch( const YAML::Exception& Exception )
+        {
+            Result.Error  = DescribeError( Exception );
+            Result.bError = true;
+        }
+
+        return Result;
+    });
+}
+
+bool FYamlDocumentStream::Next( YAML::Node& OutDoc )
+{
+    if( !Pending.IsValid() )
+    {
+        return false;
+    }
+
+    FResult Result = MoveTemp( Pending.GetResult() );
+
+    if( !Result.bFound )
+    {
+        bError  = Result.bError;
+        Error   = MoveTemp( Result.Error );
+        Pending = {};
+        return false;
+    }
+
+    // start on the next one while the caller is busy with this one
+
+    Prefetch();
+
+    OutDoc = Result.Doc;
+    return true;
+}
@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "yaml-cpp/include/node/node.h"
+#include "yaml-cpp/include/parser.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Reads the documents of a (possibly ---separated) yaml stream one at a time
+//
+// The next document is parsed on a worker thread while the caller works on the current one, so
+// there are never more than two documents in memory. The buffer must outlive the stream.
+//
+
+class FYamlDocumentStream
+{
+public:
+
+    FYamlDocumentStream( const char* Data, std::size_t Size );
+    ~FYamlDocumentStream();
+
+    // the next document, false at the end of the stream (or if it couldn't be parsed)
+    bool Next( YAML::Node& OutDoc );
+
+    // did we stop because of a parse error, and what it was
+    bool HasError() const { return bError; }
+    const FString& GetError() const { return Error; }
+
+protected:
+
+    struct FResult
+    {
+        YAML::Node  Doc;
+        FString     Error;
+        bool        bFound = false;
+        bool        bError = false;
+    };
+
+    void Prefetch();
+
+    YAML::Parser                Parser;
+    UE::Tasks::TTask<FResult>   Pending;
+    FString                     Error;
+    bool                        bError = false;
+};
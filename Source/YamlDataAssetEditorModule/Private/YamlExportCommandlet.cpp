@@ -0,0 +1,166 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlExportCommandlet.h"
+#include "YamlDataAssetEditorModule.h"
+#include "YamlExporter.h"
+#include "YamlExportPlan.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/DataAsset.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+
+//-------------------------------------------------------------------------------------------------
+
+UYamlExportCommandlet::UYamlExportCommandlet( const FObjectInitializer& ObjectInitializer )
+    : Super( ObjectInitializer )
+{
+    IsClient        = false;
+    IsServer        = false;
+    IsEditor        = true;
+    LogToConsole    = true;
+    HelpDescription = TEXT( "Export data assets as yaml files" );
+    HelpUsage       = TEXT( "-run=YamlExport -dest=<dir> [-path=/Game] [-class=<UClass>] [-batch=64] [-delta]" );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+int32 UYamlExportCommandlet::Main( const FString& Params )
+{
+    FString Dest;
+    FString Path = TEXT( "/Game" );
+    FString ClassName;
+    int32   BatchSize = 64;
+
+    FParse::Value( *Params, TEXT( "dest=" ), Dest );
+    FParse::Value( *Params, TEXT( "path=" ), Path );
+    FParse::Value( *Params, TEXT( "class=" ), ClassName );
+    FParse::Value( *Params, TEXT( "batch=" ), BatchSize );
+
+    if( Dest.IsEmpty() )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Usage: %s" ), *HelpUsage );
+        return 1;
+    }
+
+    if( FParse::Param( *Params, TEXT( "delta" ) ) )
+    {
+        IConsoleManager::Get().FindConsoleVariable( TEXT( "YamlDataAsset.DeltaExport" ) )->Set( true, ECVF_SetByCommandline );
+    }
+
+    Dest = FPaths::ConvertRelativePathToFull( Dest );
+    Path.RemoveFromEnd( TEXT( "/" ) );
+
+    BatchSize = FMath::Max( BatchSize, 1 );
+
+    // the class to export
+
+    UClass* Class = UDataAsset::StaticClass();
+
+    if( !ClassName.IsEmpty() )
+    {
+        Class = FindFirstObject<UClass>( *ClassName );
+
+        if( !Class || !Class->IsChildOf( UDataAsset::StaticClass() ) )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "%s is not a UDataAsset class" ), *ClassName );
+            return 1;
+        }
+    }
+
+    // find the assets (the registry isn't scanned up front in a commandlet)
+
+    auto& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>( TEXT( "AssetRegistry" ) ).Get();
+    AssetRegistry.SearchAllAssets( true );
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add( FName( *Path ) );
+    Filter.ClassPaths.Add( Class->GetClassPathName() );
+    Filter.bRecursivePaths   = true;
+    Filter.bRecursiveClasses = true;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets( Filter, Assets );
+
+    Assets.Sort( []( const FAssetData& A, const FAssetData& B ) { return A.PackageName.LexicalLess( B.PackageName ); } );
+
+    UE_LOG( LogYamlDataAsset, Display, TEXT( "Exporting %d assets from %s to %s" ), Assets.Num(), *Path, *Dest );
+
+    int32 NumExported = 0;
+    int32 NumFailed   = 0;
+
+    for( int32 Start = 0; Start < Assets.Num(); Start += BatchSize )
+    {
+        const int32 Count = FMath::Min( BatchSize, Assets.Num() - Start );
+
+        // load on the game thread and gather what the export needs from the property system
+
+        TArray<TStrongObjectPtr<UObject>>        Objects;
+        TArray<UObject*>                         Defaults;
+        TArray<TUniquePtr<FYamlExportPlans>>     Plans;
+        TArray<FString>                          Filenames;
+        TArray<bool>                             Written;
+
+        for( int32 Index = 0; Index < Count; ++Index )
+        {
+            const auto& Asset = Assets[ Start + Index ];
+
+            auto Object = Asset.GetAsset();
+
+            if( !Object )
+            {
+                UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s" ), *Asset.GetObjectPathString() );
+                ++NumFailed;
+                continue;
+            }
+
+            FString Relative = Asset.PackageName.ToString();
+            Relative.RightChopInline( Path.Len() + 1 );
+
+            Objects.Emplace( Object );
+            Defaults.Add( UYamlExporter::GetExportDefaults( Object ) );
+            Filenames.Add( Dest / Relative + TEXT( ".yaml" ) );
+
+            Plans.Add( MakeUnique<FYamlExportPlans>() );
+            Plans.Last()->Gather( Object->GetClass(), Object, Defaults.Last() );
+        }
+
+        Written.SetNumZeroed( Objects.Num() );
+
+        // write on worker threads, the game thread is waiting so nothing will change the objects
+        // the files are saved as UExporter::ExportToFile saves a text export, so they match the editor's
+
+        ParallelFor( Objects.Num(), [&]( int32 Index )
+        {
+            FStringOutputDevice Text;
+
+            Written[ Index ] = UYamlExporter::WriteObject( Objects[ Index ].Get(), Defaults[ Index ], Text, *Plans[ Index ] ) &&
+                               FFileHelper::SaveStringToFile( Text, *Filenames[ Index ] );
+        });
+
+        for( int32 Index = 0; Index < Objects.Num(); ++Index )
+        {
+            if( Written[ Index ] )
+            {
+                ++NumExported;
+            }
+            else
+            {
+                UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to write %s" ), *Filenames[ Index ] );
+                ++NumFailed;
+            }
+        }
+
+        Objects.Empty();
+        CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS );
+    }
+
+    UE_LOG( LogYamlDataAsset, Display, TEXT( "Exported %d assets, %d failed" ), NumExported, NumFailed );
+
+    return NumFailed > 0 ? 1 : 0;
+}
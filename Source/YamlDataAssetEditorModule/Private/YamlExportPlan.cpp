@@ -0,0 +1,410 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlExportPlan.h"
+#include "YamlImportUtils.h"
+#include "yaml-cpp/include/emitter.h"
+#include "yaml-cpp/include/fptostring.h"
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+
+//-------------------------------------------------------------------------------------------------
+// shared plans for native types
+
+static TMap<const UStruct*, TUniquePtr<FYamlExportPlan>> NativePlans;
+static FCriticalSection                                  NativePlansLock;    // exports can run on worker threads
+
+void FYamlExportPlan::Invalidate()
+{
+    FScopeLock Lock( &NativePlansLock );
+    NativePlans.Empty();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// scalar formatters - these give the same text as ExportTextItem_Direct without going through an
+// FString (apart from floats, which are written as the shortest text that reads back exactly)
+
+static void AssignUtf8( std::string& Out, const TCHAR* Text, int32 Length )
+{
+    auto String = StringCast<UTF8CHAR>( Text, Length );
+    Out.assign( (const char*) String.Get(), String.Length() );
+}
+
+static FString ExportText( const void* Address, FProperty* Property )
+{
+    FString Value;
+    Property->ExportTextItem_Direct( Value, Address, nullptr, nullptr, PPF_None );
+    return Value;
+}
+
+static void FormatText( const void* Address, FProperty* Property, std::string& Out, const FYamlExportPlans& Plans )
+{
+    // off the game thread the text was gathered up front
+
+    if( Plans.IsGathered() )
+    {
+        const auto& Value = Plans.GetText( Address );
+        AssignUtf8( Out, *Value, Value.Len() );
+        return;
+    }
+
+    const auto Value = ExportText( Address, Property );
+    AssignUtf8( Out, *Value, Value.Len() );
+}
+
+template<typename T>
+static void FormatInteger( const void* Address, FProperty* Property, std::string& Out, const FYamlExportPlans& Plans )
+{
+    char Buffer[ 24 ];
+    auto Result = std::to_chars( Buffer, Buffer + sizeof( Buffer ), *(const T*) Address );
+    Out.assign( Buffer, Result.ptr );
+}
+
+template<typename T>
+static void FormatReal( const void* Address, FProperty* Property, std::string& Out, const FYamlExportPlans& Plans )
+{
+    const T Value = *(const T*) Address;
+
+    // leave inf and nan to the text export
+
+    if( !FMath::IsFinite( Value ) )
+    {
+        FormatText( Address, Property, Out, Plans );
+        return;
+    }
+
+    if( Value == 0 )
+    {
+        Out = std::signbit( Value ) ? "-0.0" : "0.0";
+        return;
+    }
+
+    // enough digits for dragonbox's shortest representation
+
+    char Buffer[ YAML::FpToCharsSize ];
+    Out.assign( Buffer, YAML::FpToChars( Buffer, Value, std::numeric_limits<T>::max_digits10 ) );
+
+    // keep a fractional part on whole numbers, as the text export does
+
+    if( Out.find_first_of( ".e" ) == std::string::npos )
+    {
+        Out += ".0";
+    }
+}
+
+static void FormatBool( const void* Address, FProperty* Property, std::string& Out, const FYamlExportPlans& Plans )
+{
+    Out = static_cast<FBoolProperty*>( Property )->GetPropertyValue( Address ) ? "True" : "False";
+}
+
+static void FormatName( const void* Address, FProperty* Property, std::string& Out, const FYamlExportPlans& Plans )
+{
+    TStringBuilder<FName::StringBufferSize> Name;
+    static_cast<FNameProperty*>( Property )->GetPropertyValue( Address ).AppendString( Name );
+    AssignUtf8( Out, Name.GetData(), Name.Len() );
+}
+
+static void FormatString( const void* Address, FProperty* Property, std::string& Out, const FYamlExportPlans& Plans )
+{
+    const auto& Value = static_cast<FStrProperty*>( Property )->GetPropertyValue( Address );
+    AssignUtf8( Out, *Value, Value.Len() );
+}
+
+static FYamlScalarFormatter GetScalarFormatter( FProperty* Property )
+{
+    const auto CastFlags = Property->GetCastFlags();
+
+    if( CastFlags & CASTCLASS_FNumericProperty )
+    {
+        // bytes may be an enum (TEnumAsByte) so are written by name
+
+        if( CastFlags & CASTCLASS_FByteProperty )   return static_cast<FByteProperty*>( Property )->Enum ? &FormatText : &FormatInteger<uint8>;
+        if( CastFlags & CASTCLASS_FInt8Property )   return &FormatInteger<int8>;
+        if( CastFlags & CASTCLASS_FInt16Property )  return &FormatInteger<int16>;
+        if( CastFlags & CASTCLASS_FIntProperty )    return &FormatInteger<int32>;
+        if( CastFlags & CASTCLASS_FInt64Property )  return &FormatInteger<int64>;
+        if( CastFlags & CASTCLASS_FUInt16Property ) return &FormatInteger<uint16>;
+        if( CastFlags & CASTCLASS_FUInt32Property ) return &FormatInteger<uint32>;
+        if( CastFlags & CASTCLASS_FUInt64Property ) return &FormatInteger<uint64>;
+        if( CastFlags & CASTCLASS_FFloatProperty )  return &FormatReal<float>;
+        if( CastFlags & CASTCLASS_FDoubleProperty ) return &FormatReal<double>;
+    }
+
+    if( CastFlags & CASTCLASS_FBoolProperty ) return &FormatBool;
+    if( CastFlags & CASTCLASS_FNameProperty ) return &FormatName;
+    if( CastFlags & CASTCLASS_FStrProperty )  return &FormatString;
+
+    return &FormatText;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// value writers - Defaults is only passed down through structs, containers that differ from their
+// defaults are written in full (elements are matched by position, so a partial list can't be read back)
+
+static void WriteScalar( const FYamlExportValue& Value, const void* Address, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans )
+{
+    Value.Formatter( Address, Value.Property, Plans.Scratch, Plans );
+    Out << YAML::Value << Plans.Scratch;
+}
+
+static void WriteArray( const FYamlExportValue& Value, const void* Address, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans )
+{
+    Out << YAML::BeginSeq;
+
+    FScriptArrayHelper ArrayHelper( static_cast<FArrayProperty*>( Value.Property ), Address );
+
+    for( auto Index = 0; Index < ArrayHelper.Num(); ++Index )
+    {
+        Value.Element->Writer( *Value.Element, ArrayHelper.GetRawPtr( Index ), nullptr, Out, Plans );
+    }
+
+    Out << YAML::EndSeq;
+}
+
+static void WriteSet( const FYamlExportValue& Value, const void* Address, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans )
+{
+    Out << YAML::BeginSeq;
+
+    FScriptSetHelper SetHelper( static_cast<FSetProperty*>( Value.Property ), Address );
+
+    for( auto Index = 0; Index < SetHelper.Num(); ++Index )
+    {
+        Value.Element->Writer( *Value.Element, SetHelper.GetElementPtr( Index ), nullptr, Out, Plans );
+    }
+
+    Out << YAML::EndSeq;
+}
+
+static void WriteMap( const FYamlExportValue& Value, const void* Address, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans )
+{
+    Out << YAML::BeginMap;
+
+    FScriptMapHelper MapHelper( static_cast<FMapProperty*>( Value.Property ), Address );
+
+    for( auto Index = 0; Index < MapHelper.Num(); ++Index )
+    {
+        Value.Key->Formatter( MapHelper.GetKeyPtr( Index ), Value.Key->Property, Plans.Scratch, Plans );
+        Out << YAML::Key << Plans.Scratch << YAML::Value;
+
+        Value.Element->Writer( *Value.Element, MapHelper.GetValuePtr( Index ), nullptr, Out, Plans );
+    }
+
+    Out << YAML::EndMap;
+}
+
+static void WriteStruct( const FYamlExportValue& Value, const void* Address, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans )
+{
+    Out << YAML::BeginMap;
+    Plans.Get( static_cast<FStructProperty*>( Value.Property )->Struct ).WriteFields( Address, Defaults, Out, Plans );
+    Out << YAML::EndMap;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+FYamlExportValue::FYamlExportValue( FProperty* InProperty )
+    : Property( InProperty )
+    , Formatter( GetScalarFormatter( InProperty ) )
+{
+    if( auto Array = CastField<FArrayProperty>( InProperty ) )
+    {
+        Writer  = &WriteArray;
+        Element = MakeUnique<FYamlExportValue>( Array->Inner );
+    }
+    else if( auto Set = CastField<FSetProperty>( InProperty ) )
+    {
+        Writer  = &WriteSet;
+        Element = MakeUnique<FYamlExportValue>( Set->ElementProp );
+    }
+    else if( auto Map = CastField<FMapProperty>( InProperty ) )
+    {
+        Writer  = &WriteMap;
+        Key     = MakeUnique<FYamlExportValue>( Map->KeyProp );
+        Element = MakeUnique<FYamlExportValue>( Map->ValueProp );
+    }
+    else if( CastField<FStructProperty>( InProperty ) )
+    {
+        Writer = &WriteStruct;
+    }
+    else
+    {
+        Writer = &WriteScalar;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+FYamlExportPlan::FYamlExportPlan( const UStruct* InStruct )
+    : Struct( InStruct )
+{
+    for( TFieldIterator<FProperty> Field( InStruct ); Field; ++Field )
+    {
+        if( IsDataAssetField( *Field ) )
+        {
+            continue;
+        }
+
+        auto Name = StringCast<UTF8CHAR>( *Field->GetName() );
+        Keys.emplace_back( (const char*) Name.Get(), Name.Length() );
+
+        Fields.Add( { Field->GetOffset_ForInternal(), FYamlExportValue( *Field ) } );
+    }
+}
+
+void FYamlExportPlan::WriteFields( const void* Container, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans ) const
+{
+    for( int32 Index = 0; Index < Fields.Num(); ++Index )
+    {
+        const auto& Field = Fields[ Index ];
+
+        auto Address = (const uint8*) Container + Field.Offset;
+        auto Default = Defaults ? (const uint8*) Defaults + Field.Offset : nullptr;
+
+        if( Default && ( Plans.IsGathered() ? Plans.IsIdentical( Address, Field.Value.Property ) : Field.Value.Property->Identical( Address, Default, PPF_None ) ) )
+        {
+            continue;
+        }
+
+        Out << YAML::Key << Keys[ Index ] << YAML::Value;
+        Field.Value.Writer( Field.Value, Address, Default, Out, Plans );
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+const FYamlExportPlan& FYamlExportPlans::Get( const UStruct* Struct )
+{
+    if( auto Plan = Found.FindRef( Struct ) )
+    {
+        return *Plan;
+    }
+
+    const FYamlExportPlan* Plan = nullptr;
+
+    if( IsNative( Struct ) )
+    {
+        FScopeLock Lock( &NativePlansLock );
+
+        auto& Shared = NativePlans.FindOrAdd( Struct );
+
+        if( !Shared )
+        {
+            Shared = MakeUnique<FYamlExportPlan>( Struct );
+        }
+
+        Plan = Shared.Get();
+    }
+    else
+    {
+        Plan = Plans.Add( Struct, MakeUnique<FYamlExportPlan>( Struct ) ).Get();
+    }
+
+    Found.Add( Struct, Plan );
+
+    return *Plan;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// gather - this follows the writers, storing the results of the calls they make into the property
+// system rather than emitting anything
+
+static bool NeedsText( const FYamlExportValue& Value, const void* Address )
+{
+    // reals only fall back to the text export for inf and nan
+
+    if( Value.Formatter == &FormatReal<float> )
+    {
+        return !FMath::IsFinite( *(const float*) Address );
+    }
+
+    if( Value.Formatter == &FormatReal<double> )
+    {
+        return !FMath::IsFinite( *(const double*) Address );
+    }
+
+    return Value.Formatter == &FormatText;
+}
+
+void FYamlExportPlans::Gather( const UStruct* Struct, const void* Container, const void* Defaults )
+{
+    check( IsInGameThread() );
+
+    bGathered = false;
+    Texts.Reset();
+    Identical.Reset();
+
+    GatherFields( Get( Struct ), Container, Defaults );
+
+    bGathered = true;
+}
+
+void FYamlExportPlans::GatherFields( const FYamlExportPlan& Plan, const void* Container, const void* Defaults )
+{
+    for( const auto& Field : Plan.Fields )
+    {
+        auto Address = (const uint8*) Container + Field.Offset;
+        auto Default = Defaults ? (const uint8*) Defaults + Field.Offset : nullptr;
+
+        if( Default && Field.Value.Property->Identical( Address, Default, PPF_None ) )
+        {
+            Identical.Add( TPair<const void*, const FProperty*>( Address, Field.Value.Property ) );
+            continue;
+        }
+
+        GatherValue( Field.Value, Address, Default );
+    }
+}
+
+void FYamlExportPlans::GatherValue( const FYamlExportValue& Value, const void* Address, const void* Defaults )
+{
+    if( auto Array = CastField<FArrayProperty>( Value.Property ) )
+    {
+        FScriptArrayHelper ArrayHelper( Array, Address );
+
+        for( auto Index = 0; Index < ArrayHelper.Num(); ++Index )
+        {
+            GatherValue( *Value.Element, ArrayHelper.GetRawPtr( Index ), nullptr );
+        }
+    }
+    else if( auto Set = CastField<FSetProperty>( Value.Property ) )
+    {
+        FScriptSetHelper SetHelper( Set, Address );
+
+        for( auto Index = 0; Index < SetHelper.Num(); ++Index )
+        {
+            GatherValue( *Value.Element, SetHelper.GetElementPtr( Index ), nullptr );
+        }
+    }
+    else if( auto Map = CastField<FMapProperty>( Value.Property ) )
+    {
+        FScriptMapHelper MapHelper( Map, Address );
+
+        for( auto Index = 0; Index < MapHelper.Num(); ++Index )
+        {
+            // keys are always formatted as scalars
+
+            auto Key = MapHelper.GetKeyPtr( Index );
+
+            if( NeedsText( *Value.Key, Key ) )
+            {
+                Texts.Add( Key, ExportText( Key, Value.Key->Property ) );
+            }
+
+            GatherValue( *Value.Element, MapHelper.GetValuePtr( Index ), nullptr );
+        }
+    }
+    else if( auto Struct = CastField<FStructProperty>( Value.Property ) )
+    {
+        GatherFields( Get( Struct->Struct ), Address, Defaults );
+    }
+    else if( NeedsText( Value, Address ) )
+    {
+        Texts.Add( Address, ExportText( Address, Value.Property ) );
+    }
+}
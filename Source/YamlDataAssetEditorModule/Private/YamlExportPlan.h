@@ -0,0 +1,111 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <string>
+#include <vector>
+
+namespace YAML { class Emitter; }
+
+class FYamlExportPlans;
+struct FYamlExportValue;
+
+
+//-------------------------------------------------------------------------------------------------
+// pre-resolved functions to write a value of a given property type
+
+using FYamlValueWriter     = void (*)( const FYamlExportValue& Value, const void* Address, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans );
+using FYamlScalarFormatter = void (*)( const void* Address, FProperty* Property, std::string& Out, const FYamlExportPlans& Plans );
+
+struct FYamlExportValue
+{
+    explicit FYamlExportValue( FProperty* InProperty );
+
+    FProperty*                      Property  = nullptr;
+    FYamlValueWriter                Writer    = nullptr;
+    FYamlScalarFormatter            Formatter = nullptr;    // scalars and map keys
+    TUniquePtr<FYamlExportValue>    Element;                // array and set elements, map values
+    TUniquePtr<FYamlExportValue>    Key;                    // map keys
+};
+
+struct FYamlExportField
+{
+    int32            Offset;    // from the start of the container
+    FYamlExportValue Value;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Export plan - the fields of a UStruct (or UClass) with their utf-8 keys and value writers
+//
+// Nested structs are looked up through FYamlExportPlans when they are written, so recursive types
+// (a struct with an array of itself) are fine.
+//
+
+class FYamlExportPlan
+{
+public:
+
+    explicit FYamlExportPlan( const UStruct* InStruct );
+
+    const UStruct* GetStruct() const { return Struct; }
+
+    // write the fields as key/value pairs (the caller begins and ends the map), if Defaults is set
+    // then only the fields that differ from it are written
+    void WriteFields( const void* Container, const void* Defaults, YAML::Emitter& Out, FYamlExportPlans& Plans ) const;
+
+    // drop all cached plans (e.g. after a hot reload)
+    static void Invalidate();
+
+protected:
+
+    friend class FYamlExportPlans;
+
+    const UStruct*              Struct;
+    TArray<FYamlExportField>    Fields;
+    std::vector<std::string>    Keys;       // indexed as Fields (std::string can't be relocated by a TArray)
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Plans used by an export
+//
+// As FYamlImportPlans, plans for native types are shared and the rest only live as long as the
+// export. The shared plans are locked so exports can run in parallel, each export remembers the
+// plans it has used so it only takes the lock once per type.
+//
+// ExportTextItem_Direct and Identical aren't safe off the game thread for every property type
+// (object paths, FText, enum names), so an export on a worker thread calls Gather on the game thread
+// first. This keeps the text of those values and which fields match their defaults, the writers then
+// look them up by address instead of calling into the property.
+//
+
+class FYamlExportPlans
+{
+public:
+
+    const FYamlExportPlan& Get( const UStruct* Struct );
+
+    // game thread only, collect what the writers need from the property system for Container
+    void Gather( const UStruct* Struct, const void* Container, const void* Defaults );
+
+    bool IsGathered() const { return bGathered; }
+    const FString& GetText( const void* Address ) const { return Texts.FindChecked( Address ); }
+    bool IsIdentical( const void* Address, const FProperty* Property ) const { return Identical.Contains( TPair<const void*, const FProperty*>( Address, Property ) ); }
+
+    // reused for formatting scalars
+    std::string Scratch;
+
+protected:
+
+    void GatherFields( const FYamlExportPlan& Plan, const void* Container, const void* Defaults );
+    void GatherValue( const FYamlExportValue& Value, const void* Address, const void* Defaults );
+
+    TMap<const UStruct*, TUniquePtr<FYamlExportPlan>> Plans;    // non-native
+    TMap<const UStruct*, const FYamlExportPlan*>      Found;    // everything used by this export
+
+    bool                                              bGathered = false;
+    TMap<const void*, FString>                        Texts;        // by value address
+    TSet<TPair<const void*, const FProperty*>>        Identical;    // fields that match their defaults
+};
@@ -1,7 +1,20 @@
 // Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
 
 #include "YamlExporter.h"
+#include "YamlExportPlan.h"
+#include "YamlOutputBuffer.h"
+#include "HAL/IConsoleManager.h"
 #include "yaml-cpp/include/yaml.h"
+#include <ostream>
+
+
+//-------------------------------------------------------------------------------------------------
+
+static TAutoConsoleVariable<bool> CVarDeltaExport(
+    TEXT( "YamlDataAsset.DeltaExport" ),
+    false,
+    TEXT( "Only export the properties that differ from the class defaults (or archetype)" )
+);
 
 
 //-------------------------------------------------------------------------------------------------
@@ -39,72 +52,43 @@ UYamlExporter::UYamlExporter( const FObjectInitializer& ObjectInitializer )
 
 //-------------------------------------------------------------------------------------------------
 
-void ReflectProperty( void* Address, FProperty* Property, YAML::Emitter& out )
+UObject* UYamlExporter::GetExportDefaults( UObject* Object )
 {
-    if( auto Array = CastField<FArrayProperty>( Property ) )
-    {
-        out << YAML::BeginSeq;
+    // when only writing the changes, compare against what the importer will start from
 
-        FScriptArrayHelper ArrayHelper( Array, Address );
-
-        for( auto Index = 0; Index < ArrayHelper.Num(); ++Index )
-        {
-            ReflectProperty( ArrayHelper.GetElementPtr( Index ), Array->Inner, out );
-        }
-
-        out << YAML::EndSeq;
-    }
-    else if( auto Set = CastField<FSetProperty>( Property ) )
+    if( !CVarDeltaExport.GetValueOnGameThread() )
     {
-        out << YAML::BeginSeq;
-
-        FScriptSetHelper SetHelper( Set, Address );
+        return nullptr;
+    }
 
-        for( auto Index = 0; Index < SetHelper.Num(); ++Index )
-        {
-            ReflectProperty( SetHelper.GetElementPtr( Index ), Set->ElementProp, out );
-        }
+    auto Defaults = Object->GetArchetype();
 
-        out << YAML::EndSeq;
-    }
-    else if( auto Map = CastField<FMapProperty>( Property ) )
+    if( !Defaults || Defaults->GetClass() != Object->GetClass() )
     {
-        out << YAML::BeginMap;
+        Defaults = Object->GetClass()->GetDefaultObject();
+    }
 
-        FString Value;
-        FScriptMapHelper MapHelper( Map, Address );
+    return Defaults;
+}
 
-        for( auto Index = 0; Index < MapHelper.Num(); ++Index )
-        {
-            Value.Reset();
-            Map->KeyProp->ExportTextItem_Direct( Value, MapHelper.GetKeyPtr( Index ), nullptr, nullptr, PPF_None );
-            out << YAML::Key << YamlStr( Value ) << YAML::Value;
+bool UYamlExporter::WriteObject( UObject* Object, UObject* Defaults, FOutputDevice& Ar, FYamlExportPlans& Plans )
+{
+    // the emitter writes straight through to the output device
 
-            ReflectProperty( MapHelper.GetValuePtr( Index ), Map->ValueProp, out );
-        }
+    FYamlOutputBuffer Buffer( Ar );
+    std::ostream Stream( &Buffer );
+    YAML::Emitter out( Stream );
 
-        out << YAML::EndMap;
-    }
-    else if( auto Struct = CastField<FStructProperty>( Property ) )
-    {
-        out << YAML::BeginMap;
+    out << YAML::BeginMap;
+    out << YAML::Key << "__uclass" << YAML::Value << YamlStr( Object->GetClass()->GetFName() );
 
-        for( TFieldIterator<FProperty> Field( Struct->Struct ); Field; ++Field )
-        {
-            out << YAML::Key << YamlStr( Field->GetFName() ) << YAML::Value;
+    Plans.Get( Object->GetClass() ).WriteFields( Object, Defaults, out, Plans );
 
-            auto FieldAddress = Field->ContainerPtrToValuePtr<uint8>( Address );
-            ReflectProperty( FieldAddress, *Field, out );
-        }
+    out << YAML::EndMap;
 
-        out << YAML::EndMap;
-    }
-    else
-    {
-        FString Value;
-        Property->ExportTextItem_Direct( Value, Address, nullptr, nullptr, PPF_None );
-        out << YAML::Value << YamlStr( Value );
-    }
+    Buffer.Close();
+
+    return out.good();
 }
 
 
@@ -112,29 +96,8 @@ void ReflectProperty( void* Address, FProperty* Property, YAML::Emitter& out )
 
 bool UYamlExporter::ExportText( const FExportObjectInnerContext* Context, UObject* Object, const TCHAR* Type, FOutputDevice& Ar, FFeedbackContext* Warn, uint32 PortFlags )
 {
-    YAML::Emitter out;
-
-    out << YAML::BeginMap;
-    out << YAML::Key << "__uclass" << YAML::Value << YamlStr( Object->GetClass()->GetFName() );
-
-    for( TFieldIterator<FProperty> Field( Object->GetClass() ); Field; ++Field )
-    {
-        auto Key = Field->GetFName();
-        
-        if( Key == FName( "NativeClass" ) )
-        {
-            continue;
-        }
-
-        out << YAML::Key << YamlStr( Key ) << YAML::Value;
-        auto Address = Field->ContainerPtrToValuePtr<uint8>( Object );
-        ReflectProperty( Address, *Field, out );
-    }
-
-    out << YAML::EndMap;
-
-    Ar.Logf( TEXT( "%hs" ), out.c_str() );
+    FYamlExportPlans Plans;
+    WriteObject( Object, GetExportDefaults( Object ), Ar, Plans );
 
     return true;
 }
-
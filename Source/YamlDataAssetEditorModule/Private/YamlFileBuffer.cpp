@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlFileBuffer.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+
+//-------------------------------------------------------------------------------------------------
+
+bool FYamlFileBuffer::Load( const FString& Filename )
+{
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    Contents.Empty();
+
+    Data = "";
+    Size = 0;
+
+    // map the file
+
+    MappedFile.Reset( FPlatformFileManager::Get().GetPlatformFile().OpenMapped( *Filename ) );
+
+    if( MappedFile && MappedFile->GetFileSize() > 0 )
+    {
+        MappedRegion.Reset( MappedFile->MapRegion() );
+
+        if( MappedRegion )
+        {
+            Data = (const char*) MappedRegion->GetMappedPtr();
+            Size = (std::size_t) MappedRegion->GetMappedSize();
+            return true;
+        }
+    }
+
+    MappedFile.Reset();
+
+    // otherwise read it
+
+    if( !FFileHelper::LoadFileToArray( Contents, *Filename ) )
+    {
+        return false;
+    }
+
+    Data = (const char*) Contents.GetData();
+    Size = (std::size_t) Contents.Num();
+
+    return true;
+}
@@ -0,0 +1,33 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// The raw bytes of a yaml file
+//
+// The file is memory mapped where the platform supports it, otherwise it is read into memory in
+// one go. Either way the bytes are handed to yaml-cpp as they are (it deals with the encoding).
+//
+
+class FYamlFileBuffer
+{
+public:
+
+    bool Load( const FString& Filename );
+
+    const char* GetData() const { return Data; }
+    std::size_t Num() const     { return Size; }
+
+protected:
+
+    TUniquePtr<IMappedFileHandle>   MappedFile;
+    TUniquePtr<IMappedFileRegion>   MappedRegion;
+    TArray64<uint8>                 Contents;
+
+    const char*                     Data = "";
+    std::size_t                     Size = 0;
+};
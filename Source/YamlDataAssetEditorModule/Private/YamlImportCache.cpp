@@ -0,0 +1,138 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlImportCache.h"
+#include "AssetRegistry/AssetData.h"
+#include "EditorFramework/AssetImportData.h"
+#include "Hash/xxhash.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+
+static const TCHAR* SourceHashKey = TEXT( "YamlSourceHash" );
+static const TCHAR* SourceFileKey = TEXT( "YamlSourceFile" );
+static const TCHAR* SourceDocKey  = TEXT( "YamlSourceDocument" );
+
+
+//-------------------------------------------------------------------------------------------------
+
+FString FYamlImportCache::HashSource( const char* Data, std::size_t Size )
+{
+    return FString::Printf( TEXT( "%d:%016llx" ), Version, FXxHash64::HashBuffer( Data, Size ).Hash );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+static FString GetMetaValue( const UObject* Asset, const TCHAR* Key )
+{
+    auto Package = Asset ? Asset->GetPackage() : nullptr;
+
+    if( !Package || !Package->HasMetaData() )
+    {
+        return FString();
+    }
+
+    return Package->GetMetaData()->GetValue( Asset, Key );
+}
+
+// the file is stored relative to the package (or the project) as the asset import data does, so the
+// project can be moved or shared without every asset looking like it came from somewhere else
+
+static FString SanitizeFilename( const UObject* Asset, const FString& Filename )
+{
+    return Filename.IsEmpty() ? FString() : UAssetImportData::SanitizeImportFilename( Filename, Asset->GetPackage() );
+}
+
+FString FYamlImportCache::GetSourceHash( const UObject* Asset )
+{
+    return GetMetaValue( Asset, SourceHashKey );
+}
+
+void FYamlImportCache::SetSourceHash( UObject* Asset, const FString& Hash, const FString& Filename, int32 Document )
+{
+    auto MetaData = Asset->GetPackage()->GetMetaData();
+
+    // only multi-document files need the index
+
+    const FString DocumentIndex = Document > 0 ? LexToString( Document ) : FString();
+    const FString SourceFile    = SanitizeFilename( Asset, Filename );
+
+    // the meta data is saved with the package, so it needs saving even if no properties changed
+    // (e.g. only comments or formatting were edited) or the file would be parsed again every time
+
+    if( MetaData->GetValue( Asset, SourceHashKey ) != Hash ||
+        MetaData->GetValue( Asset, SourceFileKey ) != SourceFile ||
+        MetaData->GetValue( Asset, SourceDocKey ) != DocumentIndex )
+    {
+        Asset->MarkPackageDirty();
+    }
+
+    MetaData->SetValue( Asset, SourceHashKey, *Hash );
+    MetaData->SetValue( Asset, SourceFileKey, *SourceFile );
+
+    if( Document > 0 )
+    {
+        MetaData->SetValue( Asset, SourceDocKey, *DocumentIndex );
+    }
+    else
+    {
+        MetaData->RemoveValue( Asset, SourceDocKey );
+    }
+}
+
+int32 FYamlImportCache::GetSourceDocument( const UObject* Asset )
+{
+    int32 Document = 0;
+    LexFromString( Document, *GetMetaValue( Asset, SourceDocKey ) );
+    return Document;
+}
+
+FString FYamlImportCache::GetSourceFile( const UObject* Asset )
+{
+    const FString SourceFile = GetMetaValue( Asset, SourceFileKey );
+    return SourceFile.IsEmpty() ? SourceFile : UAssetImportData::ResolveImportFilename( SourceFile, Asset->GetPackage() );
+}
+
+bool FYamlImportCache::IsSourceFile( const UObject* Asset, const FString& Filename )
+{
+    const FString SourceFile = GetMetaValue( Asset, SourceFileKey );
+    return !SourceFile.IsEmpty() && SourceFile == SanitizeFilename( Asset, Filename );
+}
+
+void FYamlImportCache::SetSourceFile( UObject* Asset, const FString& Filename )
+{
+    // a new file, so whatever it is has to be imported
+    auto MetaData = Asset->GetPackage()->GetMetaData();
+
+    const FString SourceFile = SanitizeFilename( Asset, Filename );
+
+    if( MetaData->GetValue( Asset, SourceFileKey ) != SourceFile )
+    {
+        Asset->MarkPackageDirty();
+    }
+
+    MetaData->RemoveValue( Asset, SourceHashKey );
+    MetaData->RemoveValue( Asset, SourceDocKey );
+    MetaData->SetValue( Asset, SourceFileKey, *SourceFile );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+FString FYamlImportCache::GetSourceHash( const FAssetData& Asset )
+{
+    FString Hash;
+    Asset.GetTagValue( FName( SourceHashKey ), Hash );
+    return Hash;
+}
+
+void FYamlImportCache::RegisterTags()
+{
+    // UObject::GetAssetRegistryTags adds these meta data values to every asset that has them
+
+    UMetaData::GetMetaDataTagsForAssetRegistry().Add( FName( SourceHashKey ) );
+}
+
+void FYamlImportCache::UnregisterTags()
+{
+    UMetaData::GetMetaDataTagsForAssetRegistry().Remove( FName( SourceHashKey ) );
+}
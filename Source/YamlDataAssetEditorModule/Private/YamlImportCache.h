@@ -0,0 +1,46 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+
+//-------------------------------------------------------------------------------------------------
+// Remembers what an asset was imported from so unchanged files can be skipped on reimport
+//
+// The hash of the source file (and the importer version) is stored in the package meta data next
+// to the asset, it is saved with the package. The hash is also saved as an asset registry tag so a
+// batch import can check it without loading the asset.
+//
+
+class FYamlImportCache
+{
+public:
+
+    // bump this when a change to the importer means existing assets should be imported again
+    static constexpr int32 Version = 1;
+
+    // "<Version>:<xxhash64>" of the file contents
+    static FString HashSource( const char* Data, std::size_t Size );
+
+    // the hash the asset was last imported with (empty if unknown)
+    static FString GetSourceHash( const UObject* Asset );
+    static void    SetSourceHash( UObject* Asset, const FString& Hash, const FString& Filename, int32 Document = 0 );
+
+    // which document in a multi-document file the asset came from
+    static int32   GetSourceDocument( const UObject* Asset );
+
+    // the file the asset was last imported from (empty if unknown)
+    static FString GetSourceFile( const UObject* Asset );
+    static bool    IsSourceFile( const UObject* Asset, const FString& Filename );
+    static void    SetSourceFile( UObject* Asset, const FString& Filename );
+
+    // as GetSourceHash from the asset registry (empty for assets saved before the tag was registered)
+    static FString GetSourceHash( const FAssetData& Asset );
+
+    // add the meta data the registry should pick up as tags (or stop doing so)
+    static void RegisterTags();
+    static void UnregisterTags();
+};
@@ -0,0 +1,181 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlImportCommandlet.h"
+#include "YamlDataAssetEditorModule.h"
+#include "YamlImportCache.h"
+#include "YamlImportFactory.h"
+#include "YamlImportPipeline.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// <Source>/A/B.yaml -> <Dest>/A/B
+
+static FString GetPackageName( const FString& Source, const FString& Dest, const FString& Filename )
+{
+    FString Relative = FPaths::GetBaseFilename( Filename, false );
+    FPaths::MakePathRelativeTo( Relative, *( Source + TEXT( "/" ) ) );
+
+    return Dest / Relative;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+UYamlImportCommandlet::UYamlImportCommandlet( const FObjectInitializer& ObjectInitializer )
+    : Super( ObjectInitializer )
+{
+    IsClient        = false;
+    IsServer        = false;
+    IsEditor        = true;
+    LogToConsole    = true;
+    HelpDescription = TEXT( "Import a directory of yaml files as data assets" );
+    HelpUsage       = TEXT( "-run=YamlImport -source=<dir> -dest=/Game/<path> [-batch=64] [-nosave] [-force]" );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+int32 UYamlImportCommandlet::Main( const FString& Params )
+{
+    FString Source;
+    FString Dest;
+    int32   BatchSize = 64;
+
+    FParse::Value( *Params, TEXT( "source=" ), Source );
+    FParse::Value( *Params, TEXT( "dest=" ), Dest );
+    FParse::Value( *Params, TEXT( "batch=" ), BatchSize );
+
+    const bool bSave  = !FParse::Param( *Params, TEXT( "nosave" ) );
+    const bool bForce = FParse::Param( *Params, TEXT( "force" ) );
+
+    if( Source.IsEmpty() || Dest.IsEmpty() )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Usage: %s" ), *HelpUsage );
+        return 1;
+    }
+
+    Source = FPaths::ConvertRelativePathToFull( Source );
+    FPaths::NormalizeDirectoryName( Source );
+    Dest.RemoveFromEnd( TEXT( "/" ) );
+
+    BatchSize = FMath::Max( BatchSize, 1 );
+
+    // find the files
+
+    TArray<FString> Files;
+    IFileManager::Get().FindFilesRecursive( Files, *Source, TEXT( "*.yaml" ), true, false );
+    Files.Sort();
+
+    UE_LOG( LogYamlDataAsset, Display, TEXT( "Importing %d files from %s to %s" ), Files.Num(), *Source, *Dest );
+
+    // what the existing assets were imported from, so unchanged files can be skipped - this comes from
+    // the asset registry tags so nothing has to be loaded (the registry isn't scanned up front in a commandlet)
+
+    TMap<FName, FString> ExistingHashes;
+
+    if( !bForce )
+    {
+        auto& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>( TEXT( "AssetRegistry" ) ).Get();
+        AssetRegistry.SearchAllAssets( true );
+
+        TArray<FAssetData> Assets;
+        AssetRegistry.GetAssetsByPath( FName( *Dest ), Assets, true );
+
+        for( const auto& Asset : Assets )
+        {
+            if( Asset.AssetName == FPackageName::GetShortFName( Asset.PackageName ) )
+            {
+                ExistingHashes.Add( Asset.PackageName, FYamlImportCache::GetSourceHash( Asset ) );
+            }
+        }
+    }
+
+    TArray<FString> PackageNames;
+    TArray<FString> KnownHashes;
+
+    for( const auto& Filename : Files )
+    {
+        PackageNames.Add( GetPackageName( Source, Dest, Filename ) );
+        KnownHashes.Add( ExistingHashes.FindRef( FName( *PackageNames.Last() ) ) );
+    }
+
+    int32 NumImported  = 0;
+    int32 NumUnchanged = 0;
+    int32 NumFailed    = 0;
+
+    TStrongObjectPtr<UYamlImportFactory> Factory( NewObject<UYamlImportFactory>() );
+    TArray<UPackage*> Packages;
+
+    auto SavePackages = [&]()
+    {
+        if( bSave && Packages.Num() > 0 && !UEditorLoadingAndSavingUtils::SavePackages( Packages, false ) )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to save some of the packages imported from %s" ), *Source );
+            ++NumFailed;
+        }
+
+        Packages.Reset();
+        CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS );
+    };
+
+    // files are parsed on worker threads, the assets are created here in order and saved in batches
+
+    FYamlImportPipeline::Run( Files, [&]( int32 Index, const FYamlImportPipeline::FFile& File )
+    {
+        if( File.bUnchanged )
+        {
+            ++NumUnchanged;
+            return true;
+        }
+
+        TArray<UObject*> Assets;
+        const bool bImported = FYamlImportPipeline::ImportToPackage( Factory.Get(), File, PackageNames[ Index ], Files[ Index ], Assets );
+
+        // existing assets are updated in place, so there's nothing to save if neither the properties nor
+        // the source hash changed (the documents that did import are saved even if others failed)
+
+        bool bDirty = false;
+
+        for( auto Asset : Assets )
+        {
+            if( Asset->GetPackage()->IsDirty() )
+            {
+                Packages.AddUnique( Asset->GetPackage() );
+                bDirty = true;
+            }
+        }
+
+        if( !bImported )
+        {
+            ++NumFailed;
+        }
+        else if( bDirty )
+        {
+            ++NumImported;
+        }
+        else
+        {
+            ++NumUnchanged;
+        }
+
+        if( Packages.Num() >= BatchSize )
+        {
+            SavePackages();
+        }
+
+        return true;
+    }, &KnownHashes );
+
+    SavePackages();
+
+    UE_LOG( LogYamlDataAsset, Display, TEXT( "Imported %d files, %d unchanged, %d failed" ), NumImported, NumUnchanged, NumFailed );
+
+    return NumFailed > 0 ? 1 : 0;
+}
@@ -2,61 +2,35 @@
 
 #include "YamlImportFactory.h"
 #include "YamlDataAssetEditorModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/DataAsset.h"
 #include "Interfaces/IMainFrameModule.h"
 #include "Editor.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "ObjectTools.h"
+#include "YamlClassRegistry.h"
+#include "YamlDocumentStream.h"
+#include "YamlFileBuffer.h"
+#include "YamlImportCache.h"
+#include "YamlImportPlan.h"
+#include "YamlImportUtils.h"
+#include "YamlPropertyBuilder.h"
 #include "yaml-cpp/include/yaml.h"
 
 #define LOCTEXT_NAMESPACE "YamlImportFactory"
 
 
 //-------------------------------------------------------------------------------------------------
-// helper functions
-
-static constexpr uint64 ScalarTypes =
-    CASTCLASS_FBoolProperty |
-    CASTCLASS_FEnumProperty |
-    CASTCLASS_FNumericProperty |
-    CASTCLASS_FNameProperty |
-    CASTCLASS_FStrProperty |
-    CASTCLASS_FTextProperty |
-    CASTCLASS_FLargeWorldCoordinatesRealProperty |
-    CASTCLASS_FClassProperty |
-    CASTCLASS_FObjectProperty |
-    CASTCLASS_FWeakObjectProperty |
-    CASTCLASS_FLazyObjectProperty |
-    CASTCLASS_FSoftObjectProperty |
-    CASTCLASS_FSoftClassProperty;
-
-// map YAML::NodeType to supported FProperty types
-
-static uint64 GetSupportedPropertyTypeFlags( YAML::NodeType::value Type )
-{
-    switch( Type )
-    {
-        case YAML::NodeType::Undefined:
-        case YAML::NodeType::Null:      return CASTCLASS_AllFlags;
-        case YAML::NodeType::Scalar:    return ScalarTypes;
-        case YAML::NodeType::Sequence:  return CASTCLASS_FArrayProperty | CASTCLASS_FSetProperty;
-        case YAML::NodeType::Map:       return CASTCLASS_FStructProperty | CASTCLASS_FMapProperty;
-        default:                        return 0;
-    }
-}
-
-// YAML::NodeType to string for error logging
 
-static const char* GetNodeTypeName( YAML::NodeType::value Type )
-{
-    switch( Type )
-    {
-        default:                        return "Unknown";
-        case YAML::NodeType::Undefined: return "Undefined";
-        case YAML::NodeType::Null:      return "Null";
-        case YAML::NodeType::Scalar:    return "Scalar";
-        case YAML::NodeType::Sequence:  return "Sequence";
-        case YAML::NodeType::Map:       return "Map";
-    }
-}
+static TAutoConsoleVariable<bool> CVarStreamingImport(
+    TEXT( "YamlDataAsset.StreamingImport" ),
+    true,
+    TEXT( "Import yaml files in a single pass straight into the asset (false to build a YAML::Node tree first)" )
+);
 
 
 //-------------------------------------------------------------------------------------------------
@@ -65,22 +39,17 @@ static const char* GetNodeTypeName( YAML::NodeType::value Type )
 // Address : memory address of the value (this is "direct", we need to resolve the property address from the container before calling)
 // Property: property reflection data
 // Node    : yaml node to use to populate the value
+// Plans   : field lookup tables for any structs
 //
 
-static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node )
+static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node, FYamlImportPlans& Plans )
 {
     auto NodeType = Node.Type();
 
     // check we can convert the YAML::Node type to the given FProperty
 
-    if( ( Property->GetCastFlags() & GetSupportedPropertyTypeFlags( NodeType ) ) == 0 )
+    if( !CanConvertTo( Property, NodeType ) )
     {
-        UE_LOG( LogYamlDataAsset, Warning, TEXT( "Property: %s - can't convert from yaml:%hs to %s" ),
-            *Property->GetFName().ToString(),
-            GetNodeTypeName( Node.Type() ),
-            *Property->GetClass()->GetFName().ToString()
-        );
-
         return false;
     }
 
@@ -102,9 +71,7 @@ static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node )
 
         case YAML::NodeType::Scalar:
         {
-            auto ValuePtr = StringCast<TCHAR>( Node.as<std::string>().c_str() );
-            FString Value( ValuePtr.Length(), ValuePtr.Get() );
-            Property->ImportText_Direct( Value.GetCharArray().GetData(), Address, nullptr, PPF_None);
+            GetScalarSetter( Property )( Address, Property, Node.Scalar() );
         }
         break;
 
@@ -126,7 +93,7 @@ static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node )
 
                 for( std::size_t Index = 0; Index < Node.size(); ++Index )
                 {
-                    SetProperty( ArrayHelper.GetElementPtr( Index ), ArrayField->Inner, Node[ Index ] );
+                    SetProperty( ArrayHelper.GetElementPtr( Index ), ArrayField->Inner, Node[ Index ], Plans );
                 }
             }
 
@@ -150,7 +117,7 @@ static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node )
                 {
                     // parse value into the temporary element
                     ElementProp->InitializeValue_InContainer( TempElement );
-                    SetProperty( TempElement, ElementProp, Node[ Index ] );
+                    SetProperty( TempElement, ElementProp, Node[ Index ], Plans );
 
                     // add temporary element into the set (will only add if does not already exist)
                     SetHelper.AddElement( TempElement );
@@ -170,20 +137,19 @@ static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node )
 
             if( auto StructProperty = CastField<FStructProperty>( Property ) )
             {
-                auto StructClass = StructProperty->Struct;
+                auto& Plan = Plans.Get( StructProperty->Struct );
 
                 for( const auto& Child : Node )
                 {
-                    auto Key = FName ( Child.first.as<std::string>().c_str() );
+                    const auto& Key = Child.first.Scalar();
 
-                    if( auto FieldProperty = StructClass->FindPropertyByName( Key ) )
+                    if( auto Field = Plan.Find( Key ) )
                     {
-                        auto FieldAddress = FieldProperty->ContainerPtrToValuePtr<uint8>( Address );
-                        SetProperty( FieldAddress, FieldProperty, Child.second );
+                        SetProperty( (uint8*) Address + Field->Offset, Field->Property, Child.second, Plans );
                     }
                     else
                     {
-                        UE_LOG( LogYamlDataAsset, Warning, TEXT( "Failed to find property %s in %s" ), *Key.ToString(), *StructClass->GetFName().ToString() );
+                        UE_LOG( LogYamlDataAsset, Warning, TEXT( "Failed to find property %s in %s" ), UTF8_TO_TCHAR( Key.c_str() ), *StructProperty->Struct->GetFName().ToString() );
                     }
                 }
             }
@@ -198,8 +164,8 @@ static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node )
                 for( const auto& Child : Node )
                 {
                     auto MapIndex = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
-                    SetProperty( MapHelper.GetKeyPtr( MapIndex ),   MapProperty->KeyProp,   Child.first  );
-                    SetProperty( MapHelper.GetValuePtr( MapIndex ), MapProperty->ValueProp, Child.second );
+                    SetProperty( MapHelper.GetKeyPtr( MapIndex ),   MapProperty->KeyProp,   Child.first,  Plans );
+                    SetProperty( MapHelper.GetValuePtr( MapIndex ), MapProperty->ValueProp, Child.second, Plans );
                 }
 
                 MapHelper.Rehash();
@@ -224,91 +190,98 @@ static bool SetProperty( void* Address, FProperty* Property, YAML::Node Node )
 //-------------------------------------------------------------------------------------------------
 // fill in fields from given asset
 
-static UObject* ProcessObject( UObject* Asset, YAML::Node Node )
+static UObject* ProcessObject( UObject* Asset, const YAML::Node& Node )
 {
     auto Class = Asset->GetClass();
 
+    FYamlImportPlans Plans;
+    auto& Plan = Plans.Get( Class );
+
     for( const auto& Child : Node )
     {
-        auto Key = FName( Child.first.as<std::string>().c_str() );
+        const auto& Key = Child.first.Scalar();
 
         // ignore class specifier
 
-        if( Key == FName( "__uclass" ) )
+        if( FCStringAnsi::Stricmp( Key.c_str(), "__uclass" ) == 0 )
         {
             continue;
         }
 
         // look for named property in the asset
 
-        auto Property = Class->FindPropertyByName( Key );
+        auto Field = Plan.Find( Key );
 
-        if( !Property )
+        if( !Field )
         {
-            UE_LOG( LogYamlDataAsset, Warning, TEXT( "Failed to find property %s in %s" ), *Key.ToString(), *Class->GetFName().ToString() );
+            UE_LOG( LogYamlDataAsset, Warning, TEXT( "Failed to find property %s in %s" ), UTF8_TO_TCHAR( Key.c_str() ), *Class->GetFName().ToString() );
             continue;
         }
 
         // set value
 
-        auto Address = Property->ContainerPtrToValuePtr<uint8>( Asset );
-        SetProperty( Address, Property, Child.second );
+        SetProperty( (uint8*) Asset + Field->Offset, Field->Property, Child.second, Plans );
     }
 
     return Asset;
 }
 
-//-------------------------------------------------------------------------------------------------
-
-UYamlImportFactory::UYamlImportFactory( const FObjectInitializer& ObjectInitializer )
-    : Super( ObjectInitializer )
-{
-    Formats.Add( TEXT( "yaml;YAML file format for custom classes" ) );
-    SupportedClass = UDataAsset::StaticClass();
-    bCreateNew     = false;
-    bEditorImport  = true;
-}
-
 
 //-------------------------------------------------------------------------------------------------
-// get list of all registered UDataAsset's and select the given one if specified
+// Update a property of an existing asset to the value a fresh import would give it
+//
+// The new value is built in a temporary from the class default (as NewObject would start from),
+// the asset is only touched if it ends up different. Node is null for properties not in the file.
+//
 
-void UYamlImportFactory::GetDataAssets( FName FindClass )
+static bool UpdateProperty( UObject* Asset, FProperty* Property, const YAML::Node* Node, FYamlImportPlans& Plans, bool& bModified )
 {
-    SelectedClass = nullptr;
+    auto Current = Property->ContainerPtrToValuePtr<void>( Asset );
+    auto Default = Property->ContainerPtrToValuePtr<void>( Asset->GetClass()->GetDefaultObject() );
 
-    // get list of UDataAsset's
+    auto Temp = FMemory::Malloc( Property->GetSize(), Property->GetMinAlignment() );
+    Property->InitializeValue( Temp );
+    Property->CopyCompleteValue( Temp, Default );
 
-    for( TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt )
+    if( Node )
     {
-        UClass* Class = *ClassIt;
+        SetProperty( Temp, Property, *Node, Plans );
+    }
 
-        if( !Class->IsNative() )
-        {
-            continue;
-        }
+    const bool bChanged = !Property->Identical( Current, Temp, PPF_None );
 
-        if( Class->HasAnyClassFlags( CLASS_Deprecated | CLASS_NewerVersionExists ) )
+    if( bChanged )
+    {
+        if( !bModified )
         {
-            continue;
+            Asset->Modify();
+            bModified = true;
         }
 
-        if( !Class->IsChildOf( UDataAsset::StaticClass() ) || Class == UDataAsset::StaticClass() )
-        {
-            continue;
-        }
+        Asset->PreEditChange( Property );
+        Property->CopyCompleteValue( Current, Temp );
 
-        if( Class->GetFName() == FindClass )
-        {
-            SelectedClass = Class;
-        }
-
-        Classes.Add( Class );
+        FPropertyChangedEvent Event( Property, EPropertyChangeType::ValueSet );
+        Asset->PostEditChangeProperty( Event );
     }
 
-    Classes.Sort( []( UClass& A, UClass& B ) { return A.GetFName().Compare( B.GetFName() ) < 0; } );
+    Property->DestroyValue( Temp );
+    FMemory::Free( Temp );
+
+    return bChanged;
 }
-    
+
+//-------------------------------------------------------------------------------------------------
+
+UYamlImportFactory::UYamlImportFactory( const FObjectInitializer& ObjectInitializer )
+    : Super( ObjectInitializer )
+{
+    Formats.Add( TEXT( "yaml;YAML file format for custom classes" ) );
+    SupportedClass = UDataAsset::StaticClass();
+    bCreateNew     = false;
+    bEditorImport  = true;
+}
+
 
 //-------------------------------------------------------------------------------------------------
 // get user to select a UDataAsset to use from the ones registered
@@ -317,8 +290,19 @@ bool UYamlImportFactory::SelectClassModal( bool& bOutOperationCanceled )
 {
     bOutOperationCanceled = false;
 
+    // nobody to ask
+
+    if( FApp::IsUnattended() || IsRunningCommandlet() )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Unknown asset class, set __uclass in the file to import it unattended" ) );
+        bOutOperationCanceled = true;
+        return false;
+    }
+
     // select custom asset
 
+    Classes = FYamlClassRegistry::GetClasses();
+
     Modal = SNew( SWindow )
         .Title( LOCTEXT( "YamlAssetWindowTitle", "Select Custom Asset" ) )
         .SizingRule( ESizingRule::Autosized )
@@ -398,60 +382,357 @@ bool UYamlImportFactory::SelectClassModal( bool& bOutOperationCanceled )
 
 
 //-------------------------------------------------------------------------------------------------
+// create the asset, if we don't know the class (or none specified) then get the user to choose one
 
-UObject* UYamlImportFactory::FactoryCreateFile( UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, const TCHAR* Parms, FFeedbackContext* Warn, bool& bOutOperationCanceled )
+UObject* UYamlImportFactory::CreateAsset( UObject* InParent, FName InName, EObjectFlags Flags, FName ClassName, bool& bOutOperationCanceled, bool bStandIn )
 {
-    // load file
+    // look for the class set in this file (if specifed), documents without one use whatever was
+    // picked for an earlier document in the same file
 
-    FString FileContents;
+    SelectedClass = FYamlClassRegistry::Find( ClassName );
 
-    if( !FFileHelper::LoadFileToString( FileContents, *Filename ) )
+    if( !SelectedClass && ClassName.IsNone() )
     {
-        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s" ), *Filename );
+        SelectedClass = PickedClass;
+    }
+
+    if( !SelectedClass )
+    {
+        if( !SelectClassModal( bOutOperationCanceled ) )
+        {
+            return nullptr;
+        }
+
+        PickedClass = ClassName.IsNone() ? SelectedClass : PickedClass;
+    }
+
+    // don't replace an existing object of another class, whatever references it expects that type
+
+    auto Existing = FindObject<UObject>( InParent, *InName.ToString() );
+
+    if( Existing && Existing->GetClass() != SelectedClass )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Can't create a %s, %s already exists as a %s (delete it first)" ),
+            *SelectedClass->GetName(), *Existing->GetPathName(), *Existing->GetClass()->GetName() );
+
+        return nullptr;
+    }
+
+    // create the asset, or a transient stand-in for one that is already there (see ImportStreaming)
+
+    auto Asset = Existing && bStandIn
+        ? NewObject<UDataAsset>( GetTransientPackage(), SelectedClass, NAME_None, RF_Transient )
+        : NewObject<UDataAsset>( InParent, SelectedClass, InName, Flags );
+
+    if( !Asset )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to create %s asset" ), *SelectedClass->GetFName().ToString() );
         return nullptr;
     }
 
-    // parse YAML
+    return Asset;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Multi-document files - the first document is the asset being imported, the rest are created in
+// packages next to it as <Name>_1, <Name>_2, ...
+//
+// Each asset remembers the file and document it came from, so a <Name>_N that is something else
+// (e.g. imported from a Name_1.yaml) is never overwritten by another file's documents.
+//
+
+static FString GetDocumentPackageName( const FString& PackageName, int32 Document )
+{
+    return Document == 0 ? PackageName : FString::Printf( TEXT( "%s_%d" ), *PackageName, Document );
+}
+
+static UObject* FindDocumentAsset( const FString& PackageName )
+{
+    auto Package = FindPackage( nullptr, *PackageName );
+
+    if( !Package && FPackageName::DoesPackageExist( PackageName ) )
+    {
+        Package = LoadPackage( nullptr, *PackageName, LOAD_None );
+    }
+
+    return Package ? FindObject<UObject>( Package, *FPackageName::GetShortName( PackageName ) ) : nullptr;
+}
+
+static bool IsFromDocument( const UObject* Existing, const FString& Filename, int32 Document )
+{
+    const auto ExistingDocument = FYamlImportCache::GetSourceDocument( Existing );
+
+    // the first document can replace anything that isn't one of another file's extra documents
+
+    if( Document == 0 )
+    {
+        return ExistingDocument == 0;
+    }
 
-    YAML::Node Doc;
+    return ExistingDocument == Document && FYamlImportCache::IsSourceFile( Existing, Filename );
+}
 
-    try
+static bool CheckDocumentAsset( const UObject* Existing, const FString& Filename, int32 Document )
+{
+    if( !Existing || IsFromDocument( Existing, Filename, Document ) )
     {
-        auto Contents = StringCast<UTF8CHAR>( FileContents.GetCharArray().GetData() );
-        std::string Buffer( (char*) Contents.Get(), Contents.Length() );
-        Doc = YAML::Load( Buffer );
+        return true;
     }
-    catch( ... )
+
+    UE_LOG( LogYamlDataAsset, Error, TEXT( "Can't import document %d of %s to %s, it was imported from %s (rename one of them)" ),
+        Document, *Filename, *Existing->GetPathName(), *FYamlImportCache::GetSourceFile( Existing ) );
+
+    return false;
+}
+
+static UObject* GetDocumentParent( UObject* InParent, FName InName, int32 Document, const FString& Filename, FName& OutName )
+{
+    UObject* Parent = InParent;
+    OutName         = InName;
+
+    if( Document > 0 )
+    {
+        OutName = FName( *FString::Printf( TEXT( "%s_%d" ), *InName.ToString(), Document ) );
+
+        // a package that's already there is loaded so it can be checked and updated
+
+        const auto PackageName = FPackageName::GetLongPackagePath( InParent->GetOutermost()->GetName() ) / OutName.ToString();
+
+        if( auto Existing = FindDocumentAsset( PackageName ) )
+        {
+            Parent = Existing->GetOutermost();
+        }
+        else
+        {
+            Parent = CreatePackage( *PackageName );
+        }
+    }
+
+    return CheckDocumentAsset( FindObject<UObject>( Parent, *OutName.ToString() ), Filename, Document ) ? Parent : nullptr;
+}
+
+UObject* UYamlImportFactory::ImportDocument( const YAML::Node& Doc, const FString& PackageName, int32 Document, const FString& Hash, const FString& Filename )
+{
+    const auto DocumentPackageName = GetDocumentPackageName( PackageName, Document );
+    const auto Existing            = FindDocumentAsset( DocumentPackageName );
+
+    if( !CheckDocumentAsset( Existing, Filename, Document ) )
     {
-        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to parse %s" ), *Filename );
         return nullptr;
     }
 
-    if( Doc.Type() != YAML::NodeType::Map )
+    // an existing asset is updated in place (and only dirtied if something changed)
+
+    if( Existing )
+    {
+        if( !Cast<UDataAsset>( Existing ) )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "Can't import %s, %s already exists as a %s (delete it first)" ),
+                *Filename, *Existing->GetPathName(), *Existing->GetClass()->GetName() );
+
+            return nullptr;
+        }
+
+        bool bChanged = false;
+
+        if( !UpdateNode( Existing, Doc, Filename, bChanged ) )
+        {
+            return nullptr;
+        }
+
+        FYamlImportCache::SetSourceHash( Existing, Hash, Filename, Document );
+
+        return Existing;
+    }
+
+    // or created with the flags the asset tools would use
+
+    bool bCanceled = false;
+    auto Package   = CreatePackage( *DocumentPackageName );
+    auto Asset     = ImportNode( Doc, Package, FPackageName::GetShortFName( DocumentPackageName ), RF_Public | RF_Standalone | RF_Transactional, Filename, bCanceled );
+
+    if( !Asset )
     {
-        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s, expected object as the root" ), *Filename );
         return nullptr;
     }
 
-    // get all registered UDataAsset's and look for the one set in this file (if specifed)
+    FAssetRegistryModule::AssetCreated( Asset );
+    FYamlImportCache::SetSourceHash( Asset, Hash, Filename, Document );
+
+    Package->MarkPackageDirty();
+
+    return Asset;
+}
+
+void UYamlImportFactory::AddDocument( UObject* Asset, int32 Document, const FString& Hash, const FString& Filename )
+{
+    FYamlImportCache::SetSourceHash( Asset, Hash, Filename, Document );
+
+    // the first is handled by whoever called the factory
+
+    if( Document > 0 )
+    {
+        Asset->MarkPackageDirty();
+        FAssetRegistryModule::AssetCreated( Asset );
+        AdditionalImportedObjects.Add( Asset );
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// parse and fill in the fields in a single pass
+//
+// The asset is created as soon as the class is known, so a parse error further on would leave an
+// existing asset half written. Existing assets are read into a stand-in instead, which only replaces
+// the asset (in place, so references to it are kept) once the whole document has been read.
+//
+
+static UObject* ReplaceWithStandIn( UObject* StandIn, UObject* InParent, FName InName, EObjectFlags Flags )
+{
+    auto Asset = NewObject<UDataAsset>( InParent, StandIn->GetClass(), InName, Flags );
+
+    UEngine::CopyPropertiesForUnrelatedObjects( StandIn, Asset );
+    StandIn->MarkAsGarbage();
+
+    return Asset;
+}
+
+UObject* UYamlImportFactory::ImportStreaming( const FYamlFileBuffer& Buffer, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, bool& bOutOperationCanceled )
+{
+    const auto Hash = FYamlImportCache::HashSource( Buffer.GetData(), Buffer.Num() );
+
+    YAML::Parser Parser( Buffer.GetData(), Buffer.Num() );
+    UObject*     First = nullptr;
+
+    for( int32 Document = 0; !bOutOperationCanceled; ++Document )
+    {
+        UObject* Asset  = nullptr;
+        UObject* Parent = nullptr;
+        FName    Name;
+
+        FYamlPropertyBuilder Builder( [&]( FName ClassName )
+        {
+            Parent = GetDocumentParent( InParent, InName, Document, Filename, Name );
+
+            if( Parent )
+            {
+                Asset = CreateAsset( Parent, Name, Flags, ClassName, bOutOperationCanceled, true );
+            }
+
+            return Asset;
+        });
+
+        try
+        {
+            if( !Parser.HandleNextDocument( Builder ) )
+            {
+                break;
+            }
+        }
+        catch( const YAML::Exception& Exception )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to parse %s - %s" ), *Filename, *DescribeError( Exception ) );
+
+            // the asset (or stand-in) may have been created before the error, nothing has been replaced yet
+
+            if( Asset )
+            {
+                Asset->ClearFlags( RF_Public | RF_Standalone );
+                Asset->MarkAsGarbage();
+            }
+
+            break;
+        }
+
+        if( !Builder.HasRoot() )
+        {
+            // as YAML::LoadAll, an empty document ends the stream
+
+            if( Document == 0 )
+            {
+                UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s, expected object as the root" ), *Filename );
+            }
+
+            break;
+        }
+
+        if( auto Object = Builder.GetObject() )
+        {
+            if( Object->GetOuter() == GetTransientPackage() )
+            {
+                Object = ReplaceWithStandIn( Object, Parent, Name, Flags );
+            }
+
+            AddDocument( Object, Document, Hash, Filename );
+            First = Document == 0 ? Object : First;
+        }
+    }
+
+    return First;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// parse into YAML::Node trees and then fill in the fields, the next document is parsed on a worker
+// while the current one is being applied
 
-    FName FindClass = Doc[ "__uclass" ] ? FName( Doc[ "__uclass" ].as<std::string>().c_str() ) : FName();
-    GetDataAssets( FindClass );
+UObject* UYamlImportFactory::ImportTree( const FYamlFileBuffer& Buffer, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, bool& bOutOperationCanceled )
+{
+    const auto Hash = FYamlImportCache::HashSource( Buffer.GetData(), Buffer.Num() );
 
-    // if we didn't find the __uclass (or none specified) then get the user to choose one
+    FYamlDocumentStream Stream( Buffer.GetData(), Buffer.Num() );
+    YAML::Node          Doc;
+    UObject*            First = nullptr;
 
-    if( !SelectedClass && !SelectClassModal( bOutOperationCanceled ) )
+    for( int32 Document = 0; !bOutOperationCanceled && Stream.Next( Doc ); ++Document )
     {
+        FName Name;
+        auto  Parent = GetDocumentParent( InParent, InName, Document, Filename, Name );
+
+        if( !Parent )
+        {
+            continue;
+        }
+
+        if( auto Asset = ImportNode( Doc, Parent, Name, Flags, Filename, bOutOperationCanceled ) )
+        {
+            AddDocument( Asset, Document, Hash, Filename );
+            First = Document == 0 ? Asset : First;
+        }
+    }
+
+    if( Stream.HasError() )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to parse %s - %s" ), *Filename, *Stream.GetError() );
+    }
+    else if( Doc.IsNull() )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s, expected object as the root" ), *Filename );
+    }
+
+    return First;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// fill in the fields from a YAML::Node tree
+
+UObject* UYamlImportFactory::ImportNode( const YAML::Node& Doc, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, bool& bOutOperationCanceled )
+{
+    if( Doc.Type() != YAML::NodeType::Map )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s, expected object as the root" ), *Filename );
         return nullptr;
     }
 
-    // create the asset
+    // create the asset of the class set in this file (if specifed)
 
-    auto Asset = NewObject<UDataAsset>( InParent, SelectedClass, InName, Flags);
+    FName ClassName = Doc[ "__uclass" ] ? FName( Doc[ "__uclass" ].as<std::string>().c_str() ) : FName();
+    auto Asset = CreateAsset( InParent, InName, Flags, ClassName, bOutOperationCanceled );
 
     if( !Asset )
     {
-        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to create %s asset" ), *SelectedClass->GetFName().ToString() );
         return nullptr;
     }
 
@@ -461,5 +742,229 @@ UObject* UYamlImportFactory::FactoryCreateFile( UClass* InClass, UObject* InPare
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// diff the document against the asset and write the properties that changed
+
+bool UYamlImportFactory::UpdateNode( UObject* Asset, const YAML::Node& Doc, const FString& Filename, bool& bOutChanged )
+{
+    bOutChanged = false;
+
+    if( Doc.Type() != YAML::NodeType::Map )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s, expected object as the root" ), *Filename );
+        return false;
+    }
+
+    auto Class = Asset->GetClass();
+
+    if( Doc[ "__uclass" ] && Class->GetFName() != FName( Doc[ "__uclass" ].Scalar().c_str() ) )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Can't reimport %s into %s, the class has changed to %s" ), *Filename, *Asset->GetPathName(), UTF8_TO_TCHAR( Doc[ "__uclass" ].Scalar().c_str() ) );
+        return false;
+    }
+
+    FYamlImportPlans Plans;
+    auto& Plan = Plans.Get( Class );
+
+    TSet<FProperty*> Found;
+    bool bModified = false;
+
+    // the properties in the file
+
+    for( const auto& Child : Doc )
+    {
+        const auto& Key = Child.first.Scalar();
+
+        if( FCStringAnsi::Stricmp( Key.c_str(), "__uclass" ) == 0 )
+        {
+            continue;
+        }
+
+        auto Field = Plan.Find( Key );
+
+        if( !Field )
+        {
+            UE_LOG( LogYamlDataAsset, Warning, TEXT( "Failed to find property %s in %s" ), UTF8_TO_TCHAR( Key.c_str() ), *Class->GetFName().ToString() );
+            continue;
+        }
+
+        Found.Add( Field->Property );
+        UpdateProperty( Asset, Field->Property, &Child.second, Plans, bModified );
+    }
+
+    // anything that was left out goes back to the default (e.g. a delta export), apart from instanced
+    // subobjects - copying the default would point the asset at the class default object's subobject
+
+    for( TFieldIterator<FProperty> Field( Class ); Field; ++Field )
+    {
+        if( Found.Contains( *Field ) || Field->HasAnyPropertyFlags( CPF_Transient | CPF_InstancedReference | CPF_ContainsInstancedReference ) || IsDataAssetField( *Field ) )
+        {
+            continue;
+        }
+
+        UpdateProperty( Asset, *Field, nullptr, Plans, bModified );
+    }
+
+    bOutChanged = bModified;
+
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+UObject* UYamlImportFactory::FactoryCreateFile( UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, const TCHAR* Parms, FFeedbackContext* Warn, bool& bOutOperationCanceled )
+{
+    // load file
+
+    FYamlFileBuffer Buffer;
+
+    if( !Buffer.Load( Filename ) )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s" ), *Filename );
+        return nullptr;
+    }
+
+    // import every document in the file
+
+    AdditionalImportedObjects.Reset();
+    PickedClass = nullptr;
+
+    if( CVarStreamingImport.GetValueOnGameThread() )
+    {
+        return ImportStreaming( Buffer, InParent, InName, Flags, Filename, bOutOperationCanceled );
+    }
+
+    return ImportTree( Buffer, InParent, InName, Flags, Filename, bOutOperationCanceled );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// reimport - the asset is updated in place so references to it stay valid and it is only dirtied
+// if something actually changed
+
+bool UYamlImportFactory::CanReimport( UObject* Obj, TArray<FString>& OutFilenames )
+{
+    if( !Cast<UDataAsset>( Obj ) )
+    {
+        return false;
+    }
+
+    auto Filename = FYamlImportCache::GetSourceFile( Obj );
+
+    if( Filename.IsEmpty() )
+    {
+        return false;
+    }
+
+    OutFilenames.Add( Filename );
+    return true;
+}
+
+void UYamlImportFactory::SetReimportPaths( UObject* Obj, const TArray<FString>& NewReimportPaths )
+{
+    if( NewReimportPaths.Num() == 1 && Cast<UDataAsset>( Obj ) )
+    {
+        FYamlImportCache::SetSourceFile( Obj, NewReimportPaths[ 0 ] );
+    }
+}
+
+EReimportResult::Type UYamlImportFactory::Reimport( UObject* Obj )
+{
+    const auto Filename = FYamlImportCache::GetSourceFile( Obj );
+
+    FYamlFileBuffer Buffer;
+
+    if( Filename.IsEmpty() || !Buffer.Load( Filename ) )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s" ), *Filename );
+        return EReimportResult::Failed;
+    }
+
+    // nothing to do if the file is the same as last time
+
+    const auto Hash = FYamlImportCache::HashSource( Buffer.GetData(), Buffer.Num() );
+
+    if( Hash == FYamlImportCache::GetSourceHash( Obj ) )
+    {
+        return EReimportResult::Succeeded;
+    }
+
+    // the file's other documents are next to the first as <Name>_1, <Name>_2, ... so they are all
+    // updated together, whichever of them is being reimported
+
+    const auto Document    = FYamlImportCache::GetSourceDocument( Obj );
+    auto       PackageName = Obj->GetOutermost()->GetName();
+
+    if( Document > 0 )
+    {
+        PackageName.RemoveFromEnd( FString::Printf( TEXT( "_%d" ), Document ) );
+    }
+
+    FYamlDocumentStream Stream( Buffer.GetData(), Buffer.Num() );
+    YAML::Node          Doc;
+    int32               Index   = 0;
+    bool                bFailed = false;
+
+    PickedClass = nullptr;
+
+    for( ; Stream.Next( Doc ); ++Index )
+    {
+        // updates what's there, or creates the asset for a document added since the last import
+
+        if( !ImportDocument( Doc, PackageName, Index, Hash, Filename ) )
+        {
+            bFailed = true;
+        }
+    }
+
+    if( Stream.HasError() || Index <= Document )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to parse %s - %s" ), *Filename, Stream.HasError() ? *Stream.GetError() : *FString::Printf( TEXT( "document %d not found" ), Document ) );
+        return EReimportResult::Failed;
+    }
+
+    // documents that have been taken out of the file
+
+    TArray<UObject*> Removed;
+
+    for( ; ; ++Index )
+    {
+        auto Asset = FindDocumentAsset( GetDocumentPackageName( PackageName, Index ) );
+
+        if( !Asset || !IsFromDocument( Asset, Filename, Index ) )
+        {
+            break;
+        }
+
+        Removed.Add( Asset );
+    }
+
+    if( !Removed.IsEmpty() )
+    {
+        if( FApp::IsUnattended() || IsRunningCommandlet() )
+        {
+            for( auto Asset : Removed )
+            {
+                UE_LOG( LogYamlDataAsset, Warning, TEXT( "%s is no longer in %s, delete it if it isn't needed" ), *Asset->GetPathName(), *Filename );
+            }
+        }
+        else
+        {
+            // through the usual delete dialog, so references are checked and the user can keep them
+
+            ObjectTools::DeleteObjects( Removed, true );
+        }
+    }
+
+    return bFailed ? EReimportResult::Failed : EReimportResult::Succeeded;
+}
+
+int32 UYamlImportFactory::GetPriority() const
+{
+    return ImportPriority;
+}
+
+
 //-------------------------------------------------------------------------------------------------
 #undef LOCTEXT_NAMESPACE
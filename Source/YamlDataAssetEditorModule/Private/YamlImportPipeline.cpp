@@ -0,0 +1,176 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlImportPipeline.h"
+#include "YamlDataAssetEditorModule.h"
+#include "YamlDocumentStream.h"
+#include "YamlFileBuffer.h"
+#include "YamlImportCache.h"
+#include "YamlImportFactory.h"
+#include "Editor.h"
+#include "Misc/PackageName.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "Tasks/Task.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// worker thread - read a file and start parsing it
+
+struct FYamlReadFile
+{
+    TUniquePtr<FYamlFileBuffer>     Buffer;
+    TUniquePtr<FYamlDocumentStream> Docs;       // declared after the buffer it reads from
+    FString                         Hash;
+    bool                            bLoaded    = false;
+    bool                            bUnchanged = false;
+};
+
+static FYamlReadFile ReadFile( const FString& Filename, const FString& KnownHash )
+{
+    FYamlReadFile Result;
+    Result.Buffer = MakeUnique<FYamlFileBuffer>();
+
+    if( !Result.Buffer->Load( Filename ) )
+    {
+        return Result;
+    }
+
+    Result.bLoaded = true;
+
+    // skip files that haven't changed since the last import
+
+    Result.Hash = FYamlImportCache::HashSource( Result.Buffer->GetData(), Result.Buffer->Num() );
+
+    if( Result.Hash == KnownHash )
+    {
+        Result.bUnchanged = true;
+        return Result;
+    }
+
+    // the first document is parsed straight away, the rest as the previous one is committed
+
+    Result.Docs = MakeUnique<FYamlDocumentStream>( Result.Buffer->GetData(), Result.Buffer->Num() );
+
+    return Result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+void FYamlImportPipeline::Run( const TArray<FString>& Filenames, FCommit Commit, const TArray<FString>* KnownHashes )
+{
+    // don't let the workers get too far ahead, so we aren't holding every document in memory at once
+
+    const int32 MaxInFlight = FMath::Max( FPlatformMisc::NumberOfWorkerThreadsToSpawn() * 4, 8 );
+
+    TArray<UE::Tasks::TTask<FYamlReadFile>> Tasks;
+    Tasks.Reserve( Filenames.Num() );
+
+    for( int32 Index = 0; Index < Filenames.Num(); ++Index )
+    {
+        while( Tasks.Num() < Filenames.Num() && Tasks.Num() < Index + MaxInFlight )
+        {
+            const int32 Next = Tasks.Num();
+
+            FString KnownHash = KnownHashes ? ( *KnownHashes )[ Next ] : FString();
+
+            Tasks.Add( UE::Tasks::Launch( UE_SOURCE_LOCATION, [ &Filename = Filenames[ Next ], KnownHash = MoveTemp( KnownHash ) ]()
+            {
+                return ReadFile( Filename, KnownHash );
+            }));
+        }
+
+        // commit in order
+
+        const auto& Read = Tasks[ Index ].GetResult();
+
+        if( !Read.bLoaded )
+        {
+            UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s" ), *Filenames[ Index ] );
+        }
+
+        FFile File;
+        File.Docs       = Read.Docs.Get();
+        File.Hash       = Read.Hash;
+        File.bUnchanged = Read.bUnchanged;
+
+        const bool bContinue = Commit( Index, File );
+
+        // release the file
+
+        Tasks[ Index ] = {};
+
+        // don't start any more, but wait for the ones in flight as they reference the filenames
+
+        if( !bContinue )
+        {
+            for( auto& Task : Tasks )
+            {
+                if( Task.IsValid() )
+                {
+                    Task.Wait();
+                }
+            }
+
+            break;
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+bool FYamlImportPipeline::ImportToPackage( UYamlImportFactory* Factory, const FFile& File, const FString& PackageName, const FString& Filename, TArray<UObject*>& OutAssets )
+{
+    if( !File.Docs )
+    {
+        return false;
+    }
+
+    FText Reason;
+
+    if( !FPackageName::IsValidLongPackageName( PackageName, false, &Reason ) )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Can't import %s to %s - %s" ), *Filename, *PackageName, *Reason.ToString() );
+        return false;
+    }
+
+    // as the factory, the other documents of the file go next to the first
+
+    YAML::Node Doc;
+    int32      Document = 0;
+    bool       bOk      = true;
+
+    for( ; File.Docs->Next( Doc ); ++Document )
+    {
+        auto Asset = Factory->ImportDocument( Doc, PackageName, Document, File.Hash, Filename );
+
+        if( !Asset )
+        {
+            bOk = false;
+            continue;
+        }
+
+        OutAssets.Add( Asset );
+
+        // what importing through the asset tools would tell everyone else
+
+        if( GEditor )
+        {
+            GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport( Factory, Asset );
+        }
+    }
+
+    if( File.Docs->HasError() )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to parse %s - %s" ), *Filename, *File.Docs->GetError() );
+        return false;
+    }
+
+    if( Document == 0 )
+    {
+        UE_LOG( LogYamlDataAsset, Error, TEXT( "Failed to load %s, expected object as the root" ), *Filename );
+        return false;
+    }
+
+    return bOk;
+}
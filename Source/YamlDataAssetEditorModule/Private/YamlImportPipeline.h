@@ -0,0 +1,40 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FYamlDocumentStream;
+class UYamlImportFactory;
+
+
+//-------------------------------------------------------------------------------------------------
+// Import a list of files, reading and parsing them as tasks on worker threads while the game thread
+// creates the assets one at a time in the order the files were given
+//
+// Parsing only uses yaml-cpp so it is safe off the game thread, everything that touches UObjects
+// (NewObject and the property writes) happens in the commit callback. Given the source hashes the
+// assets were last imported with, files that haven't changed aren't parsed at all. The documents of
+// a multi-document file are read one at a time as they are committed (see FYamlDocumentStream).
+//
+
+class FYamlImportPipeline
+{
+public:
+
+    struct FFile
+    {
+        FYamlDocumentStream* Docs      = nullptr;  // nullptr if it couldn't be read (or is unchanged)
+        FString             Hash;                  // FYamlImportCache::HashSource of the contents
+        bool                bUnchanged = false;    // matches the known hash so wasn't parsed
+    };
+
+    // called on the game thread for each file in order, return false to stop (no more files are read)
+    using FCommit = TFunctionRef<bool( int32 Index, const FFile& File )>;
+
+    static void Run( const TArray<FString>& Filenames, FCommit Commit, const TArray<FString>* KnownHashes = nullptr );
+
+    // create (or update) the assets for each document of the file, the first in the given package and
+    // the rest next to it as with the factory - false if any of them couldn't be imported
+    static bool ImportToPackage( UYamlImportFactory* Factory, const FFile& File, const FString& PackageName, const FString& Filename, TArray<UObject*>& OutAssets );
+};
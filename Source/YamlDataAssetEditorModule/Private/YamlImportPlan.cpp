@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlImportPlan.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// shared plans for native types
+
+static TMap<const UStruct*, TUniquePtr<FYamlImportPlan>> NativePlans;
+
+void FYamlImportPlan::Invalidate()
+{
+    NativePlans.Empty();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+uint32 FYamlImportPlan::FKeyFuncs::GetKeyHash( FAnsiStringView Key )
+{
+    return HashFieldName( Key );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+FYamlImportPlan::FYamlImportPlan( const UStruct* InStruct )
+    : Struct( InStruct )
+{
+    // gather the utf-8 names first so the keys don't move when the storage grows
+
+    TArray<TPair<FProperty*, int32>> Properties;
+
+    for( TFieldIterator<FProperty> Field( InStruct ); Field; ++Field )
+    {
+        auto Name = StringCast<UTF8CHAR>( *Field->GetName() );
+
+        Properties.Emplace( *Field, Name.Length() );
+        Names.Append( (const ANSICHAR*) Name.Get(), Name.Length() );
+    }
+
+    Fields.Reserve( Properties.Num() );
+
+    int32 Offset = 0;
+
+    for( auto& Pair : Properties )
+    {
+        auto Property = Pair.Key;
+
+        FAnsiStringView Key( Names.GetData() + Offset, Pair.Value );
+        Offset += Pair.Value;
+
+        // derived class fields come first, so they hide any with the same name in the parent (as FindPropertyByName)
+
+        if( Fields.Contains( Key ) )
+        {
+            continue;
+        }
+
+        auto& Field     = Fields.Add( Key );
+        Field.Property  = Property;
+        Field.Offset    = Property->GetOffset_ForInternal();
+        Field.CastFlags = Property->GetCastFlags();
+        Field.Setter    = GetScalarSetter( Property );
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+const FYamlImportPlan& FYamlImportPlans::Get( const UStruct* Struct )
+{
+    auto& Cache = IsNative( Struct ) ? NativePlans : Plans;
+
+    if( auto Plan = Cache.Find( Struct ) )
+    {
+        return **Plan;
+    }
+
+    return *Cache.Add( Struct, MakeUnique<FYamlImportPlan>( Struct ) );
+}
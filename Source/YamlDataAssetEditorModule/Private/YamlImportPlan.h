@@ -0,0 +1,82 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YamlImportUtils.h"
+#include <string_view>
+
+
+//-------------------------------------------------------------------------------------------------
+// everything we need to set a field from a yaml key
+
+struct FYamlImportField
+{
+    FProperty*        Property  = nullptr;
+    int32             Offset    = 0;        // from the start of the container
+    uint64            CastFlags = 0;
+    FYamlScalarSetter Setter    = nullptr;  // for scalar values
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Import plan - a lookup table from yaml key to field for a UStruct (or UClass)
+//
+// Keys are matched case-insensitively (like FName) against the utf-8 yaml text, so a lookup is a
+// single hash probe without creating an FName.
+//
+
+class FYamlImportPlan
+{
+public:
+
+    explicit FYamlImportPlan( const UStruct* InStruct );
+
+    const UStruct* GetStruct() const { return Struct; }
+
+    const FYamlImportField* Find( std::string_view Key ) const
+    {
+        return Fields.Find( FAnsiStringView( Key.data(), (int32) Key.size() ) );
+    }
+
+    // drop all cached plans (e.g. after a hot reload)
+    static void Invalidate();
+
+protected:
+
+    struct FKeyFuncs : TDefaultMapKeyFuncs<FAnsiStringView, FYamlImportField, false>
+    {
+        static bool Matches( FAnsiStringView A, FAnsiStringView B )
+        {
+            return A.Len() == B.Len() && FCStringAnsi::Strnicmp( A.GetData(), B.GetData(), A.Len() ) == 0;
+        }
+
+        static uint32 GetKeyHash( FAnsiStringView Key );
+    };
+
+    const UStruct*                                                          Struct;
+    TArray<ANSICHAR>                                                        Names;      // storage for the keys
+    TMap<FAnsiStringView, FYamlImportField, FDefaultSetAllocator, FKeyFuncs> Fields;
+
+    friend class FYamlImportPlans;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Plans used by an import
+//
+// Plans for native types are shared between imports and built once per session (until the next
+// hot reload or live coding patch). User defined structs and blueprint classes can change at any
+// time in the editor so their plans only live as long as the import.
+//
+
+class FYamlImportPlans
+{
+public:
+
+    const FYamlImportPlan& Get( const UStruct* Struct );
+
+protected:
+
+    TMap<const UStruct*, TUniquePtr<FYamlImportPlan>> Plans;
+};
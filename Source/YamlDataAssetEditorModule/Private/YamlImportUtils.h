@@ -0,0 +1,261 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YamlDataAssetEditorModule.h"
+#include "Engine/DataAsset.h"
+#include "yaml-cpp/include/exceptions.h"
+#include "yaml-cpp/include/node/type.h"
+#include <charconv>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+
+//-------------------------------------------------------------------------------------------------
+// helper functions shared by the streaming (FYamlPropertyBuilder) and node tree importers (and the
+// export plans)
+
+static constexpr uint64 ScalarTypes =
+    CASTCLASS_FBoolProperty |
+    CASTCLASS_FEnumProperty |
+    CASTCLASS_FNumericProperty |
+    CASTCLASS_FNameProperty |
+    CASTCLASS_FStrProperty |
+    CASTCLASS_FTextProperty |
+    CASTCLASS_FLargeWorldCoordinatesRealProperty |
+    CASTCLASS_FClassProperty |
+    CASTCLASS_FObjectProperty |
+    CASTCLASS_FWeakObjectProperty |
+    CASTCLASS_FLazyObjectProperty |
+    CASTCLASS_FSoftObjectProperty |
+    CASTCLASS_FSoftClassProperty;
+
+// a yaml-cpp error for the log, with where it was in the file
+
+inline FString DescribeError( const YAML::Exception& Exception )
+{
+    if( Exception.mark.is_null() )
+    {
+        return UTF8_TO_TCHAR( Exception.what() );
+    }
+
+    return FString::Printf( TEXT( "line %d, column %d - %s" ), Exception.mark.line + 1, Exception.mark.column + 1, UTF8_TO_TCHAR( Exception.msg.c_str() ) );
+}
+
+// native types only change on a hot reload, so what's worked out about them can be kept until then
+
+inline bool IsNative( const UStruct* Struct )
+{
+    if( auto Class = Cast<UClass>( Struct ) )
+    {
+        return Class->IsNative();
+    }
+
+    if( auto ScriptStruct = Cast<UScriptStruct>( Struct ) )
+    {
+        return ( ScriptStruct->StructFlags & STRUCT_Native ) != 0;
+    }
+
+    return false;
+}
+
+// UDataAsset's own fields (the editor's NativeClass) are bookkeeping, not data
+
+inline bool IsDataAssetField( const FProperty* Property )
+{
+    return Property->GetOwnerClass() == UDataAsset::StaticClass();
+}
+
+// case-insensitive FNV-1a of a field name
+
+inline uint32 HashFieldName( FAnsiStringView Name )
+{
+    uint32 Hash = 2166136261u;
+
+    for( auto Ch : Name )
+    {
+        Hash = ( Hash ^ (uint8) FCharAnsi::ToLower( Ch ) ) * 16777619u;
+    }
+
+    return Hash;
+}
+
+// map YAML::NodeType to supported FProperty types
+
+inline uint64 GetSupportedPropertyTypeFlags( YAML::NodeType::value Type )
+{
+    switch( Type )
+    {
+        case YAML::NodeType::Undefined:
+        case YAML::NodeType::Null:      return CASTCLASS_AllFlags;
+        case YAML::NodeType::Scalar:    return ScalarTypes;
+        case YAML::NodeType::Sequence:  return CASTCLASS_FArrayProperty | CASTCLASS_FSetProperty;
+        case YAML::NodeType::Map:       return CASTCLASS_FStructProperty | CASTCLASS_FMapProperty;
+        default:                        return 0;
+    }
+}
+
+// YAML::NodeType to string for error logging
+
+inline const char* GetNodeTypeName( YAML::NodeType::value Type )
+{
+    switch( Type )
+    {
+        default:                        return "Unknown";
+        case YAML::NodeType::Undefined: return "Undefined";
+        case YAML::NodeType::Null:      return "Null";
+        case YAML::NodeType::Scalar:    return "Scalar";
+        case YAML::NodeType::Sequence:  return "Sequence";
+        case YAML::NodeType::Map:       return "Map";
+    }
+}
+
+// check we can convert the YAML::Node type to the given FProperty
+
+inline bool CanConvertTo( FProperty* Property, YAML::NodeType::value Type )
+{
+    if( ( Property->GetCastFlags() & GetSupportedPropertyTypeFlags( Type ) ) == 0 )
+    {
+        UE_LOG( LogYamlDataAsset, Warning, TEXT( "Property: %s - can't convert from yaml:%hs to %s" ),
+            *Property->GetFName().ToString(),
+            GetNodeTypeName( Type ),
+            *Property->GetClass()->GetFName().ToString()
+        );
+
+        return false;
+    }
+
+    return true;
+}
+
+// set a scalar property from its yaml text using the generic text import (works for any type)
+
+inline void ImportScalar( void* Address, FProperty* Property, std::string_view Text )
+{
+    // the text import wants a null terminated string, so this is the one copy
+    Property->ImportText_Direct( *FString( (int32) Text.size(), (const UTF8CHAR*) Text.data() ), Address, nullptr, PPF_None );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// typed setters - parse straight from the utf-8 text, anything they don't understand (hex, enum
+// names, trailing garbage, etc) falls back to ImportScalar so the results match ImportText_Direct
+
+template<typename T>
+inline void SetIntegerScalar( void* Address, FProperty* Property, std::string_view Text )
+{
+    T Value;
+
+    auto Result = std::from_chars( Text.data(), Text.data() + Text.size(), Value );
+
+    if( Result.ec == std::errc() && Result.ptr == Text.data() + Text.size() )
+    {
+        *(T*) Address = Value;
+    }
+    else
+    {
+        ImportScalar( Address, Property, Text );
+    }
+}
+
+template<typename T>
+inline void SetRealScalar( void* Address, FProperty* Property, std::string_view Text )
+{
+    // only plain decimal numbers, leave things like "+1" and ".inf" to the text import
+
+    const char* Start = Text.data();
+    const char* End   = Text.data() + Text.size();
+
+    if( Start == End || !( FCharAnsi::IsDigit( *Start ) || *Start == '-' || *Start == '.' ) )
+    {
+        ImportScalar( Address, Property, Text );
+        return;
+    }
+
+#if defined( __cpp_lib_to_chars )
+
+    double Value;
+    auto Result = std::from_chars( Start, End, Value );
+    bool bParsed = Result.ec == std::errc() && Result.ptr == End;
+
+#else
+
+    char* ParseEnd = nullptr;
+    double Value = std::strtod( Start, &ParseEnd );
+    bool bParsed = ParseEnd == End;
+
+#endif
+
+    if( bParsed )
+    {
+        *(T*) Address = (T) Value;
+    }
+    else
+    {
+        ImportScalar( Address, Property, Text );
+    }
+}
+
+inline void SetBoolScalar( void* Address, FProperty* Property, std::string_view Text )
+{
+    auto BoolProperty = static_cast<FBoolProperty*>( Property );
+    auto Value        = FAnsiStringView( Text.data(), (int32) Text.size() );
+
+    if( Value.Equals( "true", ESearchCase::IgnoreCase ) || Value.Equals( "yes", ESearchCase::IgnoreCase ) || Text == "1" )
+    {
+        BoolProperty->SetPropertyValue( Address, true );
+    }
+    else if( Value.Equals( "false", ESearchCase::IgnoreCase ) || Value.Equals( "no", ESearchCase::IgnoreCase ) || Text == "0" )
+    {
+        BoolProperty->SetPropertyValue( Address, false );
+    }
+    else
+    {
+        ImportScalar( Address, Property, Text );
+    }
+}
+
+inline void SetNameScalar( void* Address, FProperty* Property, std::string_view Text )
+{
+    *static_cast<FNameProperty*>( Property )->GetPropertyValuePtr( Address ) = FName( (int32) Text.size(), (const UTF8CHAR*) Text.data() );
+}
+
+inline void SetStringScalar( void* Address, FProperty* Property, std::string_view Text )
+{
+    *static_cast<FStrProperty*>( Property )->GetPropertyValuePtr( Address ) = FString( (int32) Text.size(), (const UTF8CHAR*) Text.data() );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// pre-resolved function to set a scalar property of a given type
+
+using FYamlScalarSetter = void (*)( void* Address, FProperty* Property, std::string_view Text );
+
+inline FYamlScalarSetter GetScalarSetter( FProperty* Property )
+{
+    const auto CastFlags = Property->GetCastFlags();
+
+    if( CastFlags & CASTCLASS_FNumericProperty )
+    {
+        // bytes may be an enum (TEnumAsByte) so can be set by name
+
+        if( CastFlags & CASTCLASS_FByteProperty )   return static_cast<FByteProperty*>( Property )->Enum ? &ImportScalar : &SetIntegerScalar<uint8>;
+        if( CastFlags & CASTCLASS_FInt8Property )   return &SetIntegerScalar<int8>;
+        if( CastFlags & CASTCLASS_FInt16Property )  return &SetIntegerScalar<int16>;
+        if( CastFlags & CASTCLASS_FIntProperty )    return &SetIntegerScalar<int32>;
+        if( CastFlags & CASTCLASS_FInt64Property )  return &SetIntegerScalar<int64>;
+        if( CastFlags & CASTCLASS_FUInt16Property ) return &SetIntegerScalar<uint16>;
+        if( CastFlags & CASTCLASS_FUInt32Property ) return &SetIntegerScalar<uint32>;
+        if( CastFlags & CASTCLASS_FUInt64Property ) return &SetIntegerScalar<uint64>;
+        if( CastFlags & CASTCLASS_FFloatProperty )  return &SetRealScalar<float>;
+        if( CastFlags & CASTCLASS_FDoubleProperty ) return &SetRealScalar<double>;
+    }
+
+    if( CastFlags & CASTCLASS_FBoolProperty ) return &SetBoolScalar;
+    if( CastFlags & CASTCLASS_FNameProperty ) return &SetNameScalar;
+    if( CastFlags & CASTCLASS_FStrProperty )  return &SetStringScalar;
+
+    return &ImportScalar;
+}
@@ -0,0 +1,111 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlOutputBuffer.h"
+
+
+//-------------------------------------------------------------------------------------------------
+
+FYamlOutputBuffer::FYamlOutputBuffer( FOutputDevice& InAr )
+    : Ar( InAr )
+    , bAutoEmitLineTerminator( InAr.GetAutoEmitLineTerminator() )
+{
+    // the document goes out in several pieces, so only the last one should be terminated
+
+    Ar.SetAutoEmitLineTerminator( false );
+    setp( Buffer, Buffer + ChunkSize );
+}
+
+FYamlOutputBuffer::~FYamlOutputBuffer()
+{
+    Close();
+}
+
+void FYamlOutputBuffer::Close()
+{
+    if( bClosed )
+    {
+        return;
+    }
+
+    bClosed = true;
+
+    Ar.SetAutoEmitLineTerminator( bAutoEmitLineTerminator );
+    Flush( true );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+FYamlOutputBuffer::int_type FYamlOutputBuffer::overflow( int_type Ch )
+{
+    Flush( false );
+
+    if( traits_type::eq_int_type( Ch, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( Ch );
+    }
+
+    *pptr() = traits_type::to_char_type( Ch );
+    pbump( 1 );
+
+    return Ch;
+}
+
+int FYamlOutputBuffer::sync()
+{
+    Flush( false );
+    return 0;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+void FYamlOutputBuffer::Flush( bool bFinal )
+{
+    int32 Count    = (int32)( pptr() - pbase() );
+    int32 Complete = Count;
+
+    // hold back an incomplete utf-8 sequence at the end of the buffer
+
+    if( !bFinal )
+    {
+        for( int32 Back = 1; Back <= 4 && Back <= Count; ++Back )
+        {
+            auto Byte = (uint8) Buffer[ Count - Back ];
+
+            if( ( Byte & 0xC0 ) == 0x80 )
+            {
+                continue; // continuation byte
+            }
+
+            int32 Length = Byte >= 0xF0 ? 4 : Byte >= 0xE0 ? 3 : Byte >= 0xC0 ? 2 : 1;
+
+            if( Length > Back )
+            {
+                Complete = Count - Back;
+            }
+
+            break;
+        }
+    }
+
+    // write it
+
+    if( Complete > 0 || bFinal )
+    {
+        auto Converted = StringCast<TCHAR>( (const UTF8CHAR*) Buffer, Complete );
+
+        Chunk.Reset();
+        Chunk.Append( Converted.Get(), Converted.Length() );
+        Chunk.Add( TEXT( '\0' ) );
+
+        Ar.Serialize( Chunk.GetData(), ELogVerbosity::Log, NAME_None );
+    }
+
+    // move what's left to the start
+
+    FMemory::Memmove( Buffer, Buffer + Complete, Count - Complete );
+
+    setp( Buffer, Buffer + ChunkSize );
+    pbump( Count - Complete );
+}
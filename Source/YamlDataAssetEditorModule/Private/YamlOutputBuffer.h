@@ -0,0 +1,41 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <streambuf>
+
+
+//-------------------------------------------------------------------------------------------------
+// A std::streambuf that forwards the utf-8 emitter output to an FOutputDevice in fixed sized chunks
+//
+// This lets a YAML::Emitter write straight to the exporter's output device rather than building
+// the whole document in memory first. A chunk never ends part way through a utf-8 sequence, the
+// trailing bytes are held back for the next one.
+//
+
+class FYamlOutputBuffer : public std::streambuf
+{
+public:
+
+    explicit FYamlOutputBuffer( FOutputDevice& InAr );
+    virtual ~FYamlOutputBuffer();
+
+    // write out everything that is left, the device's line terminator (if any) follows the last chunk
+    void Close();
+
+protected:
+
+    virtual int_type overflow( int_type Ch ) override;
+    virtual int sync() override;
+
+    void Flush( bool bFinal );
+
+    static constexpr int32 ChunkSize = 16 * 1024;
+
+    FOutputDevice&  Ar;
+    bool            bAutoEmitLineTerminator;
+    bool            bClosed = false;
+    TArray<TCHAR>   Chunk;
+    char            Buffer[ ChunkSize ];
+};
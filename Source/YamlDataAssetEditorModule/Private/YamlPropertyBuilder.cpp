@@ -0,0 +1,568 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#include "YamlPropertyBuilder.h"
+#include "YamlDataAssetEditorModule.h"
+#include "YamlImportUtils.h"
+
+
+//-------------------------------------------------------------------------------------------------
+
+FYamlPropertyBuilder::FYamlPropertyBuilder( FCreateObject InCreateObject )
+    : CreateObject( MoveTemp( InCreateObject ) )
+{
+    Tapes.SetNum( 1 ); // since the anchors start at 1
+}
+
+FYamlPropertyBuilder::~FYamlPropertyBuilder()
+{
+    // only if the parse failed part way through
+
+    for( auto& Frame : Frames )
+    {
+        if( Frame.Type == EFrame::Set )
+        {
+            if( Frame.bElement )
+            {
+                CastFieldChecked<FSetProperty>( Frame.Property )->ElementProp->DestroyValue( Frame.Element );
+            }
+
+            FMemory::Free( Frame.Element );
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// create the object once we know the class and apply anything we have seen so far
+
+void FYamlPropertyBuilder::ResolveObject( FName ClassName )
+{
+    bResolved = true;
+    Object    = CreateObject( ClassName );
+
+    if( !Object )
+    {
+        return;
+    }
+
+    auto& Root   = Frames[ 0 ];
+    Root.Plan    = &Plans.Get( Object->GetClass() );
+    Root.Address = Object;
+
+    Replay( YAML::NullAnchor, RootMark );
+    Tapes[ YAML::NullAnchor ] = FTape();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// get the address and property the next value should be written to
+//
+// returns false if the value should be ignored
+//
+
+bool FYamlPropertyBuilder::BeginValue( FSlot& OutSlot, YAML::NodeType::value Type )
+{
+    if( Frames.IsEmpty() )
+    {
+        return false;
+    }
+
+    auto& Frame = Frames.Top();
+
+    switch( Frame.Type )
+    {
+        case EFrame::Object:
+        case EFrame::Struct:
+        {
+            // only scalar keys are supported (handled in OnScalar), a non-scalar __uclass means we still don't know the class
+
+            if( Frame.bKey || !Frame.Field )
+            {
+                bClassName = false;
+                return false;
+            }
+
+            OutSlot.Address  = (uint8*) Frame.Address + Frame.Field->Offset;
+            OutSlot.Property = Frame.Field->Property;
+            OutSlot.Setter   = Frame.Field->Setter;
+        }
+        break;
+
+        case EFrame::Array:
+        {
+            auto ArrayProperty = CastFieldChecked<FArrayProperty>( Frame.Property );
+
+            // overwrite the existing elements first, then grow the array
+
+            FScriptArrayHelper ArrayHelper( ArrayProperty, Frame.Address );
+
+            if( Frame.Index >= ArrayHelper.Num() )
+            {
+                ArrayHelper.AddValue();
+            }
+
+            OutSlot.Address  = ArrayHelper.GetElementPtr( Frame.Index++ );
+            OutSlot.Property = ArrayProperty->Inner;
+            OutSlot.Setter   = Frame.Setter;
+        }
+        break;
+
+        case EFrame::Set:
+        {
+            // parse the value into the temporary element
+
+            auto ElementProp = CastFieldChecked<FSetProperty>( Frame.Property )->ElementProp;
+            ElementProp->InitializeValue( Frame.Element );
+            Frame.bElement = true;
+
+            OutSlot.Address  = Frame.Element;
+            OutSlot.Property = ElementProp;
+            OutSlot.Setter   = Frame.Setter;
+        }
+        break;
+
+        case EFrame::Map:
+        {
+            auto MapProperty = CastFieldChecked<FMapProperty>( Frame.Property );
+
+            FScriptMapHelper MapHelper( MapProperty, Frame.Address );
+
+            if( Frame.bKey )
+            {
+                Frame.Index      = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
+                OutSlot.Address  = MapHelper.GetKeyPtr( Frame.Index );
+                OutSlot.Property = MapProperty->KeyProp;
+                OutSlot.Setter   = Frame.KeySetter;
+            }
+            else
+            {
+                OutSlot.Address  = MapHelper.GetValuePtr( Frame.Index );
+                OutSlot.Property = MapProperty->ValueProp;
+                OutSlot.Setter   = Frame.Setter;
+            }
+        }
+        break;
+
+        default:
+        {
+            return false;
+        }
+    }
+
+    return CanConvertTo( OutSlot.Property, Type );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// a value has been completed, move the parent container on to the next one
+
+void FYamlPropertyBuilder::EndValue()
+{
+    if( Frames.IsEmpty() )
+    {
+        return;
+    }
+
+    auto& Frame = Frames.Top();
+
+    switch( Frame.Type )
+    {
+        case EFrame::Object:
+        case EFrame::Struct:
+        {
+            Frame.bKey  = !Frame.bKey;
+            Frame.Field = Frame.bKey ? nullptr : Frame.Field;
+        }
+        break;
+
+        case EFrame::Map:
+        {
+            Frame.bKey = !Frame.bKey;
+        }
+        break;
+
+        case EFrame::Set:
+        {
+            // add temporary element into the set (will only add if does not already exist)
+
+            auto SetProperty = CastFieldChecked<FSetProperty>( Frame.Property );
+
+            FScriptSetHelper SetHelper( SetProperty, Frame.Address );
+            SetHelper.AddElement( Frame.Element );
+
+            SetProperty->ElementProp->DestroyValue( Frame.Element );
+            Frame.bElement = false;
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+void FYamlPropertyBuilder::PushFrame( EFrame Type, const FSlot& Slot )
+{
+    auto& Frame    = Frames.AddDefaulted_GetRef();
+    Frame.Type     = Type;
+    Frame.Address  = Slot.Address;
+    Frame.Property = Slot.Property;
+
+    // resolve the field lookup and setters once for the whole container
+
+    switch( Type )
+    {
+        case EFrame::Struct:
+        {
+            Frame.Plan = &Plans.Get( CastFieldChecked<FStructProperty>( Slot.Property )->Struct );
+        }
+        break;
+
+        case EFrame::Array:
+        {
+            Frame.Setter = GetScalarSetter( CastFieldChecked<FArrayProperty>( Slot.Property )->Inner );
+        }
+        break;
+
+        case EFrame::Set:
+        {
+            // empty the set and create a container for a temporary element
+
+            auto SetProperty = CastFieldChecked<FSetProperty>( Slot.Property );
+
+            FScriptSetHelper SetHelper( SetProperty, Slot.Address );
+            SetHelper.EmptyElements();
+
+            auto ElementProp = SetProperty->ElementProp;
+            Frame.Element = (uint8*) FMemory::Malloc( ElementProp->GetSize(), ElementProp->GetMinAlignment() );
+            Frame.Setter  = GetScalarSetter( ElementProp );
+        }
+        break;
+
+        case EFrame::Map:
+        {
+            auto MapProperty = CastFieldChecked<FMapProperty>( Slot.Property );
+
+            FScriptMapHelper MapHelper( MapProperty, Slot.Address );
+            MapHelper.EmptyValues();
+
+            Frame.KeySetter = GetScalarSetter( MapProperty->KeyProp );
+            Frame.Setter    = GetScalarSetter( MapProperty->ValueProp );
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void FYamlPropertyBuilder::PopFrame()
+{
+    auto Frame = Frames.Pop();
+
+    switch( Frame.Type )
+    {
+        case EFrame::Array:
+        {
+            // remove any elements we didn't overwrite
+
+            FScriptArrayHelper ArrayHelper( CastFieldChecked<FArrayProperty>( Frame.Property ), Frame.Address );
+            ArrayHelper.Resize( Frame.Index );
+        }
+        break;
+
+        case EFrame::Set:
+        {
+            FMemory::Free( Frame.Element );
+        }
+        break;
+
+        case EFrame::Map:
+        {
+            FScriptMapHelper MapHelper( CastFieldChecked<FMapProperty>( Frame.Property ), Frame.Address );
+            MapHelper.Rehash();
+        }
+        break;
+
+        default:
+        break;
+    }
+
+    EndValue();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// recording and playback of events
+//
+// an anchored value is recorded as it is parsed so an alias can replay it later, root keys are
+// recorded until the object has been created
+//
+
+void FYamlPropertyBuilder::Record( FEvent::EType Type, YAML::anchor_t Anchor, std::string_view Value )
+{
+    const bool bStart = Type == FEvent::SequenceStart || Type == FEvent::MapStart;
+    const bool bEnd   = Type == FEvent::SequenceEnd   || Type == FEvent::MapEnd;
+
+    if( !bEnd )
+    {
+        // root key or value before we know the class
+
+        if( bHasRoot && Frames.Num() == 1 && !bResolved && !bClassName )
+        {
+            Recorders.Add( { (int32) YAML::NullAnchor, 0 } );
+        }
+
+        // anchored value
+
+        if( Anchor != YAML::NullAnchor )
+        {
+            auto Tape = (int32) Anchor;
+
+            if( Tape >= Tapes.Num() )
+            {
+                Tapes.SetNum( Tape + 1 );
+            }
+
+            Tapes[ Tape ].Events.Reset();
+            Tapes[ Tape ].Text.Reset();
+            Recorders.Add( { Tape, 0 } );
+        }
+    }
+
+    if( Recorders.IsEmpty() )
+    {
+        return;
+    }
+
+    for( auto& Recorder : Recorders )
+    {
+        auto& Tape = Tapes[ Recorder.Tape ];
+
+        Tape.Events.Add( { Type, Tape.Text.Num(), (int32) Value.size() } );
+        Tape.Text.Append( Value.data(), (int32) Value.size() );
+
+        Recorder.Depth += bStart ? 1 : bEnd ? -1 : 0;
+    }
+
+    // recording stops when we get back to the level it started at
+
+    Recorders.RemoveAll( []( const FRecorder& Recorder ) { return Recorder.Depth == 0; } );
+}
+
+bool FYamlPropertyBuilder::IsRecording( int32 Tape ) const
+{
+    return Recorders.ContainsByPredicate( [Tape]( const FRecorder& Recorder ) { return Recorder.Tape == Tape; } );
+}
+
+void FYamlPropertyBuilder::Replay( int32 Tape, const YAML::Mark& Mark )
+{
+    static const std::string NoTag;
+
+    // note that the tape can't change whilst we are replaying it, events are replayed without anchors
+    // and we don't allow recursive aliases
+
+    for( int32 Index = 0; Index < Tapes[ Tape ].Events.Num(); ++Index )
+    {
+        const auto Event = Tapes[ Tape ].Events[ Index ];
+
+        switch( Event.Type )
+        {
+            case FEvent::Null:          OnNull( Mark, YAML::NullAnchor ); break;
+            case FEvent::Scalar:        OnScalarView( Mark, NoTag, YAML::NullAnchor, std::string_view( Tapes[ Tape ].Text.GetData() + Event.Offset, Event.Length ) ); break;
+            case FEvent::SequenceStart: OnSequenceStart( Mark, NoTag, YAML::NullAnchor, YAML::EmitterStyle::Default ); break;
+            case FEvent::SequenceEnd:   OnSequenceEnd(); break;
+            case FEvent::MapStart:      OnMapStart( Mark, NoTag, YAML::NullAnchor, YAML::EmitterStyle::Default ); break;
+            case FEvent::MapEnd:        OnMapEnd(); break;
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// YAML::EventHandler
+
+void FYamlPropertyBuilder::OnDocumentStart( const YAML::Mark& Mark )
+{
+}
+
+void FYamlPropertyBuilder::OnDocumentEnd()
+{
+}
+
+void FYamlPropertyBuilder::OnNull( const YAML::Mark& Mark, YAML::anchor_t Anchor )
+{
+    Record( FEvent::Null, Anchor );
+
+    // NodeType::Null -> clear property
+
+    FSlot Slot;
+
+    if( BeginValue( Slot, YAML::NodeType::Null ) )
+    {
+        Slot.Property->ClearValue( Slot.Address );
+    }
+
+    EndValue();
+}
+
+void FYamlPropertyBuilder::OnAlias( const YAML::Mark& Mark, YAML::anchor_t Anchor )
+{
+    auto Tape = (int32) Anchor;
+
+    if( Tape <= 0 || Tape >= Tapes.Num() || IsRecording( Tape ) )
+    {
+        UE_LOG( LogYamlDataAsset, Warning, TEXT( "Unsupported alias at line %d" ), Mark.line + 1 );
+        OnNull( Mark, YAML::NullAnchor );
+        return;
+    }
+
+    Replay( Tape, Mark );
+}
+
+void FYamlPropertyBuilder::OnScalar( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, const std::string& Value )
+{
+    OnScalarView( Mark, Tag, Anchor, Value );
+}
+
+void FYamlPropertyBuilder::OnScalarView( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, std::string_view Value )
+{
+    if( !Frames.IsEmpty() )
+    {
+        auto& Frame = Frames.Top();
+
+        // the class name, we can create the object now
+
+        if( bClassName )
+        {
+            bClassName = false;
+            Frame.bKey = true;
+            ResolveObject( FName( (int32) Value.size(), Value.data() ) );
+            return;
+        }
+
+        // field name
+
+        if( ( Frame.Type == EFrame::Object || Frame.Type == EFrame::Struct ) && Frame.bKey )
+        {
+            Frame.bKey = false;
+
+            // class specifier
+
+            if( Frame.Type == EFrame::Object && FAnsiStringView( Value.data(), (int32) Value.size() ).Equals( "__uclass", ESearchCase::IgnoreCase ) )
+            {
+                bClassName = !bResolved;
+                return;
+            }
+
+            Record( FEvent::Scalar, Anchor, Value );
+
+            if( !Frame.Plan )
+            {
+                return;
+            }
+
+            Frame.Field = Frame.Plan->Find( Value );
+
+            if( !Frame.Field )
+            {
+                UE_LOG( LogYamlDataAsset, Warning, TEXT( "Failed to find property %s in %s" ), *FString( (int32) Value.size(), (const UTF8CHAR*) Value.data() ), *Frame.Plan->GetStruct()->GetFName().ToString() );
+            }
+
+            return;
+        }
+    }
+
+    Record( FEvent::Scalar, Anchor, Value );
+
+    // NodeType::Scalar -> FProperty value type
+
+    FSlot Slot;
+
+    if( BeginValue( Slot, YAML::NodeType::Scalar ) )
+    {
+        Slot.Setter( Slot.Address, Slot.Property, Value );
+    }
+
+    EndValue();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// NodeType::Sequence[] -> TArray or a TSet
+
+void FYamlPropertyBuilder::OnSequenceStart( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, YAML::EmitterStyle::value Style )
+{
+    Record( FEvent::SequenceStart, Anchor );
+
+    FSlot Slot;
+
+    if( !BeginValue( Slot, YAML::NodeType::Sequence ) )
+    {
+        PushFrame( EFrame::Skip, Slot );
+    }
+    else if( CastField<FArrayProperty>( Slot.Property ) )
+    {
+        PushFrame( EFrame::Array, Slot );
+    }
+    else
+    {
+        PushFrame( EFrame::Set, Slot );
+    }
+}
+
+void FYamlPropertyBuilder::OnSequenceEnd()
+{
+    Record( FEvent::SequenceEnd, YAML::NullAnchor );
+    PopFrame();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// NodeType::Map{} -> UObject, UStruct or TMap
+
+void FYamlPropertyBuilder::OnMapStart( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, YAML::EmitterStyle::value Style )
+{
+    Record( FEvent::MapStart, Anchor );
+
+    // root object
+
+    if( Frames.IsEmpty() && !bHasRoot )
+    {
+        bHasRoot = true;
+        RootMark = Mark;
+        PushFrame( EFrame::Object, FSlot() );
+        return;
+    }
+
+    FSlot Slot;
+
+    if( !BeginValue( Slot, YAML::NodeType::Map ) )
+    {
+        PushFrame( EFrame::Skip, Slot );
+    }
+    else if( CastField<FStructProperty>( Slot.Property ) )
+    {
+        PushFrame( EFrame::Struct, Slot );
+    }
+    else
+    {
+        PushFrame( EFrame::Map, Slot );
+    }
+}
+
+void FYamlPropertyBuilder::OnMapEnd()
+{
+    Record( FEvent::MapEnd, YAML::NullAnchor );
+
+    // no __uclass specified
+
+    if( Frames.Num() == 1 && !bResolved )
+    {
+        ResolveObject( NAME_None );
+    }
+
+    PopFrame();
+}
@@ -0,0 +1,138 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YamlImportPlan.h"
+#include "yaml-cpp/include/eventhandler.h"
+#include "yaml-cpp/include/mark.h"
+#include "yaml-cpp/include/node/type.h"
+#include <string>
+#include <string_view>
+
+
+//-------------------------------------------------------------------------------------------------
+// Streaming importer - a YAML::EventHandler that writes values directly into the properties of an
+// object as the parser produces them (rather than building a YAML::Node tree and walking it).
+//
+// The object is created via the CreateObject callback as soon as the class is known, which is
+// either when the root __uclass key is read or at the end of the root map if there isn't one. Any
+// root keys that appear before that are recorded and replayed once the object exists.
+//
+
+class FYamlPropertyBuilder : public YAML::EventHandler
+{
+public:
+
+    using FCreateObject = TFunction<UObject*( FName ClassName )>;
+
+    explicit FYamlPropertyBuilder( FCreateObject InCreateObject );
+    virtual ~FYamlPropertyBuilder();
+
+    // was the document root a map (i.e. something we can import)
+    bool HasRoot() const { return bHasRoot; }
+
+    // the populated object (nullptr if it was not created)
+    UObject* GetObject() const { return Object; }
+
+    // YAML::EventHandler
+
+    virtual void OnDocumentStart( const YAML::Mark& Mark ) override;
+    virtual void OnDocumentEnd() override;
+
+    virtual void OnNull( const YAML::Mark& Mark, YAML::anchor_t Anchor ) override;
+    virtual void OnAlias( const YAML::Mark& Mark, YAML::anchor_t Anchor ) override;
+    virtual void OnScalar( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, const std::string& Value ) override;
+    virtual void OnScalarView( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, std::string_view Value ) override;
+
+    virtual void OnSequenceStart( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, YAML::EmitterStyle::value Style ) override;
+    virtual void OnSequenceEnd() override;
+
+    virtual void OnMapStart( const YAML::Mark& Mark, const std::string& Tag, YAML::anchor_t Anchor, YAML::EmitterStyle::value Style ) override;
+    virtual void OnMapEnd() override;
+
+protected:
+
+    // a container we are currently writing into
+
+    enum class EFrame : uint8
+    {
+        Object,     // root object, fields are written by key
+        Struct,     // FStructProperty, fields are written by key
+        Array,      // FArrayProperty, elements are written in order
+        Set,        // FSetProperty, elements are written to a temporary and then added
+        Map,        // FMapProperty, alternating key and value
+        Skip,       // unsupported or unknown, ignore everything until the end
+    };
+
+    struct FFrame
+    {
+        EFrame                  Type;
+        void*                   Address   = nullptr;    // address of the container value (or object)
+        FProperty*              Property  = nullptr;    // container property (nullptr for Object and Skip)
+        const FYamlImportPlan*  Plan      = nullptr;    // Object and Struct field lookup
+        const FYamlImportField* Field     = nullptr;    // Object and Struct field for the current key
+        FYamlScalarSetter       Setter    = nullptr;    // Array, Set and Map element (or value) setter
+        FYamlScalarSetter       KeySetter = nullptr;    // Map key setter
+        uint8*                  Element   = nullptr;    // Set temporary element
+        int32                   Index     = 0;          // Array next element, Map current pair
+        bool                    bKey      = true;       // Object, Struct and Map - expecting a key next
+        bool                    bElement  = false;      // Set temporary element holds a value
+    };
+
+    // where the next value should be written
+
+    struct FSlot
+    {
+        void*             Address  = nullptr;
+        FProperty*        Property = nullptr;
+        FYamlScalarSetter Setter   = nullptr;
+    };
+
+    // events are recorded for anchors (so aliases can be replayed) and for any root keys we see
+    // before the object has been created
+
+    struct FEvent
+    {
+        enum EType : uint8 { Null, Scalar, SequenceStart, SequenceEnd, MapStart, MapEnd };
+
+        EType Type;
+        int32 Offset;   // scalar value in FTape::Text
+        int32 Length;
+    };
+
+    struct FTape
+    {
+        TArray<FEvent>   Events;
+        TArray<ANSICHAR> Text;
+    };
+
+    struct FRecorder
+    {
+        int32 Tape;
+        int32 Depth;
+    };
+
+    bool BeginValue( FSlot& OutSlot, YAML::NodeType::value Type );
+    void EndValue();
+    void PushFrame( EFrame Type, const FSlot& Slot );
+    void PopFrame();
+
+    void ResolveObject( FName ClassName );
+
+    void Record( FEvent::EType Type, YAML::anchor_t Anchor, std::string_view Value = {} );
+    void Replay( int32 Tape, const YAML::Mark& Mark );
+    bool IsRecording( int32 Tape ) const;
+
+    FCreateObject       CreateObject;
+    FYamlImportPlans    Plans;
+    UObject*            Object      = nullptr;
+    bool                bHasRoot    = false;
+    bool                bResolved   = false;    // have we called CreateObject
+    bool                bClassName  = false;    // next value is the __uclass
+    YAML::Mark          RootMark;
+
+    TArray<FFrame>          Frames;
+    TArray<FTape>           Tapes;              // indexed by anchor, 0 (YAML::NullAnchor) holds the pending root keys
+    TArray<FRecorder>       Recorders;
+};
@@ -0,0 +1,24 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "YamlBenchmarkCommandlet.generated.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Benchmark the import and export paths without the editor UI
+//
+//  UnrealEditor-Cmd <Project> -run=YamlBenchmark -nullrhi -unattended [-iterations=5] [-scale=1] [-csv=<file>]
+//
+
+UCLASS()
+class UYamlBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+
+    virtual int32 Main( const FString& Params ) override;
+};
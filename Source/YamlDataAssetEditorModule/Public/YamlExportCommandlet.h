@@ -0,0 +1,28 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "YamlExportCommandlet.generated.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Export data assets to yaml files without the editor UI
+//
+//  UnrealEditor-Cmd <Project> -run=YamlExport -dest=<dir> [-path=/Game] [-class=<UClass>] [-batch=64] [-delta]
+//
+// Assets are found through the asset registry and loaded in batches on the game thread, the yaml
+// for each batch is then written on worker threads. /Game/<path>/A/B becomes <dir>/A/B.yaml (the
+// layout the YamlImport commandlet expects).
+//
+
+UCLASS()
+class UYamlExportCommandlet : public UCommandlet
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+
+    virtual int32 Main( const FString& Params ) override;
+};
@@ -9,6 +9,7 @@
 #include "YamlExporter.generated.h"
 
 class FExportObjectInnerContext;
+class FYamlExportPlans;
 
 UCLASS()
 class UYamlExporter : public UExporter
@@ -17,5 +18,13 @@ class UYamlExporter : public UExporter
 
 public:
     virtual bool ExportText( const FExportObjectInnerContext* Context, UObject* Object, const TCHAR* Type, FOutputDevice& Ar, FFeedbackContext* Warn, uint32 PortFlags = 0 ) override;
+
+    // the object to compare against for a delta export (nullptr to write everything), game thread only
+    static UObject* GetExportDefaults( UObject* Object );
+
+    // write the object as a yaml document to Ar, returns false if the emitter failed - on the game thread
+    // Plans can be empty, elsewhere it must have been gathered for the object first (see FYamlExportPlans)
+    // and nothing can change the object while it is written
+    static bool WriteObject( UObject* Object, UObject* Defaults, FOutputDevice& Ar, FYamlExportPlans& Plans );
 };
 
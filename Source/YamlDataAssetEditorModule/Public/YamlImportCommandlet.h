@@ -0,0 +1,28 @@
+// Copyright (C) 2024 Gwaredd Mountain - All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "YamlImportCommandlet.generated.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Import (or reimport) every yaml file under a directory without the editor UI
+//
+//  UnrealEditor-Cmd <Project> -run=YamlImport -source=<dir> -dest=/Game/<path> [-batch=64] [-nosave] [-force]
+//
+// Files are read and parsed on worker threads, the assets are created on the game thread and saved
+// in batches of packages. <dir>/A/B.yaml becomes /Game/<path>/A/B. Files that haven't changed since
+// the asset was last imported are skipped (unless -force).
+//
+
+UCLASS()
+class UYamlImportCommandlet : public UCommandlet
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+
+    virtual int32 Main( const FString& Params ) override;
+};
@@ -4,10 +4,14 @@
 
 #include "Factories/Factory.h"
 #include "CoreMinimal.h"
+#include "EditorReimportHandler.h"
 #include "YamlImportFactory.generated.h"
 
+class FYamlFileBuffer;
+namespace YAML { class Node; }
+
 UCLASS( hidecategories = Object )
-class UYamlImportFactory : public UFactory
+class UYamlImportFactory : public UFactory, public FReimportHandler
 {
     GENERATED_UCLASS_BODY()
 
@@ -15,14 +19,34 @@ public:
 
     virtual UObject* FactoryCreateFile( UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, const TCHAR* Parms, FFeedbackContext* Warn, bool& bOutOperationCanceled ) override;
 
+    // create the asset from an already parsed document (e.g. one loaded on another thread)
+    UObject* ImportNode( const YAML::Node& Doc, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, bool& bOutOperationCanceled );
+
+    // update an existing asset in place from a parsed document, only the properties that differ are written
+    bool UpdateNode( UObject* Asset, const YAML::Node& Doc, const FString& Filename, bool& bOutChanged );
+
+    // create or update the asset for a document of a file, the first goes in the given package and the rest next to it as <Name>_N
+    UObject* ImportDocument( const YAML::Node& Doc, const FString& PackageName, int32 Document, const FString& Hash, const FString& Filename );
+
+    // FReimportHandler
+    virtual bool CanReimport( UObject* Obj, TArray<FString>& OutFilenames ) override;
+    virtual void SetReimportPaths( UObject* Obj, const TArray<FString>& NewReimportPaths ) override;
+    virtual EReimportResult::Type Reimport( UObject* Obj ) override;
+    virtual int32 GetPriority() const override;
+
 
 protected:
 
     bool SelectClassModal( bool& bOutOperationCanceled );
-    void GetDataAssets( FName FindClass );
+
+    UObject* CreateAsset( UObject* InParent, FName InName, EObjectFlags Flags, FName ClassName, bool& bOutOperationCanceled, bool bStandIn = false );
+    UObject* ImportStreaming( const FYamlFileBuffer& Buffer, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, bool& bOutOperationCanceled );
+    UObject* ImportTree( const FYamlFileBuffer& Buffer, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, bool& bOutOperationCanceled );
+    void     AddDocument( UObject* Asset, int32 Document, const FString& Hash, const FString& Filename );
 
 
     TSharedPtr<SWindow> Modal;
-    TArray<UClass*>     Classes;
+    TArray<UClass*>     Classes;        // for the class picker
     UClass*             SelectedClass = nullptr;
+    UClass*             PickedClass   = nullptr;  // chosen by the user for an earlier document in the file
 };
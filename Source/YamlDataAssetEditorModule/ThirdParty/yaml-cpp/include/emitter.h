@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <charconv>
 #include <cmath>
 #include <cstddef>
 #include <limits>
@@ -86,11 +87,13 @@ class YAML_CPP_API Emitter {
 
  private:
   template <typename T>
-  void SetStreamablePrecision(std::stringstream&) {}
+  std::size_t GetStreamablePrecision() const {
+    return 6;
+  }
   std::size_t GetFloatPrecision() const;
   std::size_t GetDoublePrecision() const;
 
-  void PrepareIntegralStream(std::stringstream& stream) const;
+  int GetIntegralBase() const;
   void StartedScalar();
 
  private:
@@ -141,11 +144,23 @@ inline Emitter& Emitter::WriteIntegralType(T value) {
 
   PrepareNode(EmitterNodeType::Scalar);
 
-  std::stringstream stream;
-  stream.imbue(std::locale("C"));
-  PrepareIntegralStream(stream);
-  stream << value;
-  m_stream << stream.str();
+  // formatted on the stack and written straight out, like a stream hex and
+  // octal are of the unsigned bits (so -1 is 0xffffffff)
+  char buffer[std::numeric_limits<T>::digits / 3 + 4];
+  std::to_chars_result result;
+  const int base = GetIntegralBase();
+  if (base == 10) {
+    result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  } else {
+    using unsigned_type = typename std::make_unsigned<T>::type;
+    result = std::to_chars(buffer, buffer + sizeof(buffer),
+                           static_cast<unsigned_type>(value), base);
+    if (base == 16)
+      m_stream << "0x";
+    else
+      m_stream << '0';
+  }
+  m_stream.write(buffer, static_cast<std::size_t>(result.ptr - buffer));
 
   StartedScalar();
 
@@ -159,48 +174,37 @@ inline Emitter& Emitter::WriteStreamable(T value) {
 
   PrepareNode(EmitterNodeType::Scalar);
 
-  std::stringstream stream;
-  stream.imbue(std::locale("C"));
-  SetStreamablePrecision<T>(stream);
-
-  bool special = false;
-  if (std::is_floating_point<T>::value) {
-    if ((std::numeric_limits<T>::has_quiet_NaN ||
-         std::numeric_limits<T>::has_signaling_NaN) &&
-        std::isnan(value)) {
-      special = true;
-      stream << ".nan";
-    } else if (std::numeric_limits<T>::has_infinity && std::isinf(value)) {
-      special = true;
-      if (std::signbit(value)) {
-        stream << "-.inf";
-      } else {
-        stream << ".inf";
-      }
+  if ((std::numeric_limits<T>::has_quiet_NaN ||
+       std::numeric_limits<T>::has_signaling_NaN) &&
+      std::isnan(value)) {
+    m_stream << ".nan";
+  } else if (std::numeric_limits<T>::has_infinity && std::isinf(value)) {
+    if (std::signbit(value)) {
+      m_stream << "-.inf";
+    } else {
+      m_stream << ".inf";
     }
+  } else {
+    char buffer[FpToCharsSize];
+    char* end = FpToChars(buffer, value, GetStreamablePrecision<T>());
+    m_stream.write(buffer, static_cast<std::size_t>(end - buffer));
   }
 
-  if (!special) {
-    stream << FpToString(value, stream.precision());
-  }
-  m_stream << stream.str();
-
   StartedScalar();
 
   return *this;
 }
 
 template <>
-inline void Emitter::SetStreamablePrecision<float>(std::stringstream& stream) {
-  stream.precision(static_cast<std::streamsize>(GetFloatPrecision()));
+inline std::size_t Emitter::GetStreamablePrecision<float>() const {
+  return GetFloatPrecision();
 }
 
 template <>
-inline void Emitter::SetStreamablePrecision<double>(std::stringstream& stream) {
-  stream.precision(static_cast<std::streamsize>(GetDoublePrecision()));
+inline std::size_t Emitter::GetStreamablePrecision<double>() const {
+  return GetDoublePrecision();
 }
 
-// overloads of insertion
 inline Emitter& operator<<(Emitter& emitter, const std::string& v) {
   return emitter.Write(v);
 }
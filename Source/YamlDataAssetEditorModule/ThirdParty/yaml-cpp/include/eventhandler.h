@@ -8,6 +8,7 @@
 #endif
 
 #include <string>
+#include <string_view>
 
 #include "yaml-cpp/include/anchor.h"
 #include "yaml-cpp/include/emitterstyle.h"
@@ -27,6 +28,13 @@ class EventHandler {
   virtual void OnScalar(const Mark& mark, const std::string& tag,
                         anchor_t anchor, const std::string& value) = 0;
 
+  // the parser calls this, value may be a view of the input that is only valid
+  // for the duration of the call (by default it is copied for OnScalar)
+  virtual void OnScalarView(const Mark& mark, const std::string& tag,
+                            anchor_t anchor, std::string_view value) {
+    OnScalar(mark, tag, anchor, std::string(value));
+  }
+
   virtual void OnSequenceStart(const Mark& mark, const std::string& tag,
                                anchor_t anchor, EmitterStyle::value style) = 0;
   virtual void OnSequenceEnd() = 0;
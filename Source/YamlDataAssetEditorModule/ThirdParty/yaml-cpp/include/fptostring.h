@@ -3,6 +3,7 @@
 
 #include "yaml-cpp/include/dll.h"
 
+#include <cstddef>
 #include <string>
 
 namespace YAML {
@@ -10,6 +11,13 @@ namespace YAML {
 YAML_CPP_API std::string FpToString(float v, size_t precision = 0);
 YAML_CPP_API std::string FpToString(double v, size_t precision = 0);
 YAML_CPP_API std::string FpToString(long double v, size_t precision = 0);
+
+// the same, written to a buffer of at least FpToCharsSize chars (rather than
+// allocating a string), returns the end of what was written
+constexpr std::size_t FpToCharsSize = 32;
+YAML_CPP_API char* FpToChars(char* buffer, float v, size_t precision = 0);
+YAML_CPP_API char* FpToChars(char* buffer, double v, size_t precision = 0);
+YAML_CPP_API char* FpToChars(char* buffer, long double v, size_t precision = 0);
 }
 
 #endif
@@ -8,6 +8,7 @@
 #endif
 
 #include <array>
+#include <charconv>
 #include <cmath>
 #include <limits>
 #include <list>
@@ -118,26 +119,136 @@ struct convert<_Null> {
 };
 
 namespace conversion {
+// C locale whitespace, which the stream allows after a number
+inline bool IsSpace(char ch) { return ch == ' ' || (ch >= '\t' && ch <= '\r'); }
+
+// the characters a stream reads as one char (rather than a number)
+template <typename T>
+struct IsCharType
+    : std::integral_constant<bool, std::is_same<T, char>::value ||
+                                       std::is_same<T, signed char>::value ||
+                                       std::is_same<T, unsigned char>::value> {};
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, std::string>::type
+Encode(const T& rhs) {
+  if (std::isnan(rhs))
+    return ".nan";
+  if (std::isinf(rhs))
+    return std::signbit(rhs) ? "-.inf" : ".inf";
+  return FpToString(rhs, std::numeric_limits<T>::max_digits10);
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !IsCharType<T>::value,
+                        std::string>::type
+Encode(const T& rhs) {
+  char buffer[std::numeric_limits<T>::digits10 + 3];
+  std::to_chars_result result =
+      std::to_chars(buffer, buffer + sizeof(buffer), rhs);
+  return std::string(buffer, result.ptr);
+}
+
 template <typename T>
-typename std::enable_if< std::is_floating_point<T>::value, void>::type
-inner_encode(const T& rhs, std::stringstream& stream){
-  if (std::isnan(rhs)) {
-    stream << ".nan";
-  } else if (std::isinf(rhs)) {
-    if (std::signbit(rhs)) {
-      stream << "-.inf";
+typename std::enable_if<IsCharType<T>::value, std::string>::type Encode(
+    const T& rhs) {
+  return std::string(1, static_cast<char>(rhs));
+}
+
+// ConvertTo
+// . Reads the usual forms of a number without a stream, the same as a stream
+//   with no base set would (0x.. is hex and 0.. is octal). Returns false if it
+//   isn't one of those, in which case the stream has the final say.
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value &&
+                            !std::is_same<T, char>::value,
+                        bool>::type
+ConvertTo(const std::string& input, T& rhs) {
+  const char* first = input.data();
+  const char* last = first + input.size();
+  while (last != first && IsSpace(last[-1]))
+    --last;
+
+  bool negative = false;
+  if (first != last && (*first == '-' || *first == '+')) {
+    negative = (*first == '-');
+    ++first;
+  }
+
+  int base = 10;
+  if (last - first > 1 && first[0] == '0') {
+    if (first[1] == 'x' || first[1] == 'X') {
+      base = 16;
+      first += 2;
     } else {
-      stream << ".inf";
+      base = 8;
+      first += 1;
     }
+  }
+
+  unsigned long long magnitude;
+  std::from_chars_result result = std::from_chars(first, last, magnitude, base);
+  if (result.ec != std::errc() || result.ptr != last)
+    return false;
+
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  const unsigned long long max =
+      static_cast<unsigned_type>((std::numeric_limits<T>::max)());
+
+  if (!negative) {
+    if (magnitude > max)
+      return false;
+    rhs = static_cast<T>(magnitude);
   } else {
-    stream << FpToString(rhs, stream.precision());
+    if (std::is_unsigned<T>::value || magnitude > max + 1)
+      return false;
+    rhs = magnitude == max + 1 ? (std::numeric_limits<T>::min)()
+                               : static_cast<T>(-static_cast<T>(magnitude));
   }
+  return true;
 }
 
 template <typename T>
-typename std::enable_if<!std::is_floating_point<T>::value, void>::type
-inner_encode(const T& rhs, std::stringstream& stream){
-  stream << rhs;
+typename std::enable_if<std::is_same<T, char>::value, bool>::type ConvertTo(
+    const std::string& input, T& rhs) {
+  if (input.size() != 1)
+    return false;
+  rhs = input[0];
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+ConvertTo(const std::string& input, T& rhs) {
+#if defined(__cpp_lib_to_chars)
+  const char* first = input.data();
+  const char* last = first + input.size();
+  while (last != first && IsSpace(last[-1]))
+    --last;
+
+  // (from_chars doesn't take a +, and would take inf and nan)
+  bool negative = false;
+  if (first != last && (*first == '-' || *first == '+')) {
+    negative = (*first == '-');
+    ++first;
+  }
+
+  if (first == last || !(*first == '.' || (*first >= '0' && *first <= '9')))
+    return false;
+
+  T value;
+  std::from_chars_result result =
+      std::from_chars(first, last, value, std::chars_format::general);
+  if (result.ec != std::errc() || result.ptr != last)
+    return false;
+
+  rhs = negative ? -value : value;
+  return true;
+#else
+  (void)input;
+  (void)rhs;
+  return false;
+#endif
 }
 
 template <typename T>
@@ -171,11 +282,7 @@ ConvertStreamTo(std::stringstream& stream, T& rhs) {
   struct convert<type> {                                                   \
                                                                            \
     static Node encode(const type& rhs) {                                  \
-      std::stringstream stream;                                            \
-      stream.imbue(std::locale("C"));                                       \
-      stream.precision(std::numeric_limits<type>::max_digits10);           \
-      conversion::inner_encode(rhs, stream);                               \
-      return Node(stream.str());                                           \
+      return Node(conversion::Encode(rhs));                                \
     }                                                                      \
                                                                            \
     static bool decode(const Node& node, type& rhs) {                      \
@@ -183,13 +290,11 @@ ConvertStreamTo(std::stringstream& stream, T& rhs) {
         return false;                                                      \
       }                                                                    \
       const std::string& input = node.Scalar();                            \
-      std::stringstream stream(input);                                     \
-      stream.imbue(std::locale("C"));                                       \
-      stream.unsetf(std::ios::dec);                                        \
-      if ((stream.peek() == '-') && std::is_unsigned<type>::value) {       \
+      if (std::is_unsigned<type>::value && !input.empty() &&               \
+          input[0] == '-') {                                               \
         return false;                                                      \
       }                                                                    \
-      if (conversion::ConvertStreamTo(stream, rhs)) {                      \
+      if (conversion::ConvertTo(input, rhs)) {                             \
         return true;                                                       \
       }                                                                    \
       if (std::numeric_limits<type>::has_infinity) {                       \
@@ -209,7 +314,11 @@ ConvertStreamTo(std::stringstream& stream, T& rhs) {
         }                                                                  \
       }                                                                    \
                                                                            \
-      return false;                                                        \
+      /* anything unusual is read by a stream, as it always was */         \
+      std::stringstream stream(input);                                     \
+      stream.imbue(std::locale("C"));                                      \
+      stream.unsetf(std::ios::dec);                                        \
+      return conversion::ConvertStreamTo(stream, rhs);                     \
     }                                                                      \
   }
 
@@ -11,8 +11,14 @@
 #include "yaml-cpp/include/node/detail/node_data.h"
 
 #include <algorithm>
+#include <cstring>
+#include <string>
 #include <type_traits>
 
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
+#include <string_view>
+#endif
+
 namespace YAML {
 namespace detail {
 template <typename Key, typename Enable = void>
@@ -96,6 +102,37 @@ struct remove_idx<Key,
   }
 };
 
+// keys that node::equals compares as strings, so they can be looked up by
+// their bytes (see node_data::find_map_key)
+template <typename Key>
+struct string_key : std::false_type {};
+
+template <>
+struct string_key<std::string> : std::true_type {
+  static const char* data(const std::string& key) { return key.data(); }
+  static std::size_t size(const std::string& key) { return key.size(); }
+};
+
+template <>
+struct string_key<const char*> : std::true_type {
+  static const char* data(const char* key) { return key; }
+  static std::size_t size(const char* key) { return std::strlen(key); }
+};
+
+template <>
+struct string_key<char*> : string_key<const char*> {};
+
+template <std::size_t N>
+struct string_key<char[N]> : string_key<const char*> {};
+
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
+template <>
+struct string_key<std::string_view> : std::true_type {
+  static const char* data(std::string_view key) { return key.data(); }
+  static std::size_t size(std::string_view key) { return key.size(); }
+};
+#endif
+
 template <typename T>
 inline bool node::equals(const T& rhs, shared_memory_holder pMemory) {
   T lhs;
@@ -131,11 +168,7 @@ inline node* node_data::get(const Key& key,
       throw BadSubscript(m_mark, key);
   }
 
-  auto it = std::find_if(m_map.begin(), m_map.end(), [&](const kv_pair m) {
-    return m.first->equals(key, pMemory);
-  });
-
-  return it != m_map.end() ? it->second : nullptr;
+  return find_map_value(key, pMemory, string_key<Key>());
 }
 
 template <typename Key>
@@ -157,12 +190,11 @@ inline node& node_data::get(const Key& key, shared_memory_holder pMemory) {
       throw BadSubscript(m_mark, key);
   }
 
-  auto it = std::find_if(m_map.begin(), m_map.end(), [&](const kv_pair m) {
-    return m.first->equals(key, pMemory);
-  });
+  // pick up any keys changed in place since the index was built
+  index_map_keys();
 
-  if (it != m_map.end()) {
-    return *it->second;
+  if (node* pValue = find_map_value(key, pMemory, string_key<Key>())) {
+    return *pValue;
   }
 
   node& k = convert_to_node(key, pMemory);
@@ -193,6 +225,7 @@ inline bool node_data::remove(const Key& key, shared_memory_holder pMemory) {
 
     if (iter != m_map.end()) {
       m_map.erase(iter);
+      clear_map_index();
       return true;
     }
   }
@@ -200,6 +233,24 @@ inline bool node_data::remove(const Key& key, shared_memory_holder pMemory) {
   return false;
 }
 
+template <typename Key>
+inline node* node_data::find_map_value(const Key& key,
+                                       const shared_memory_holder& pMemory,
+                                       std::false_type) const {
+  auto it = std::find_if(m_map.begin(), m_map.end(), [&](const kv_pair m) {
+    return m.first->equals(key, pMemory);
+  });
+
+  return it != m_map.end() ? it->second : nullptr;
+}
+
+template <typename Key>
+inline node* node_data::find_map_value(const Key& key,
+                                       const shared_memory_holder& /* pMemory */,
+                                       std::true_type) const {
+  return find_map_key(string_key<Key>::data(key), string_key<Key>::size(key));
+}
+
 // map
 template <typename Key, typename Value>
 inline void node_data::force_insert(const Key& key, const Value& value,
@@ -7,6 +7,8 @@
 #pragma once
 #endif
 
+#include <cstddef>
+#include <memory>
 #include <set>
 
 #include "yaml-cpp/include/dll.h"
@@ -22,13 +24,17 @@ namespace YAML {
 namespace detail {
 class YAML_CPP_API memory {
  public:
-  memory() : m_nodes{} {}
+  memory() : m_blocks{}, m_pCurrent{} {}
   node& create_node();
   void merge(const memory& rhs);
 
  private:
-  using Nodes = std::set<shared_node>;
-  Nodes m_nodes;
+  // nodes are allocated from blocks, which are shared with any memory this is
+  // merged into and freed all at once when the last of them goes
+  class block;
+  using Blocks = std::set<std::shared_ptr<block>>;
+  Blocks m_blocks;
+  block* m_pCurrent;
 };
 
 class YAML_CPP_API memory_holder {
@@ -24,7 +24,7 @@ class node {
   };
 
  public:
-  node() : m_pRef(new node_ref), m_dependencies{}, m_index{} {}
+  node() : m_pRef(std::make_shared<node_ref>()), m_dependencies{}, m_index{} {}
   node(const node&) = delete;
   node& operator=(const node&) = delete;
 
@@ -63,6 +63,10 @@ class node {
   void set_ref(const node& rhs) {
     if (rhs.is_defined())
       mark_defined();
+    if (m_pRef->is_map_key()) {
+      rhs.m_pRef->mark_map_key(*m_pRef);
+      m_pRef->map_key_changed();
+    }
     m_pRef = rhs.m_pRef;
   }
   void set_data(const node& rhs) {
@@ -72,6 +76,9 @@ class node {
   }
 
   void set_mark(const Mark& mark) { m_pRef->set_mark(mark); }
+  void mark_map_key(const node_data::key_index_epoch& epoch) {
+    m_pRef->mark_map_key(epoch);
+  }
 
   void set_type(NodeType::value type) {
     if (type != NodeType::Undefined)
@@ -82,9 +89,9 @@ class node {
     mark_defined();
     m_pRef->set_null();
   }
-  void set_scalar(const std::string& scalar) {
+  void set_scalar(std::string scalar) {
     mark_defined();
-    m_pRef->set_scalar(scalar);
+    m_pRef->set_scalar(std::move(scalar));
   }
   void set_tag(const std::string& tag) {
     mark_defined();
@@ -9,7 +9,9 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -38,7 +40,7 @@ class YAML_CPP_API node_data {
   void set_type(NodeType::value type);
   void set_tag(const std::string& tag);
   void set_null();
-  void set_scalar(const std::string& scalar);
+  void set_scalar(std::string scalar);
   void set_style(EmitterStyle::value style);
 
   bool is_defined() const { return m_isDefined; }
@@ -50,6 +52,15 @@ class YAML_CPP_API node_data {
   const std::string& tag() const { return m_tag; }
   EmitterStyle::value style() const { return m_style; }
 
+  // is this used as a key in any indexed map (so changing it affects the key
+  // index), the epoch is shared between a map and its keys
+  using key_index_epoch = std::shared_ptr<std::size_t>;
+
+  bool is_map_key() const { return !m_keyOf.empty(); }
+  void mark_map_key(const key_index_epoch& epoch);
+  void mark_map_key(const node_data& rhs);  // a key of the same maps as rhs
+  void map_key_changed();
+
   // size/iterator
   std::size_t size() const;
 
@@ -97,6 +108,18 @@ class YAML_CPP_API node_data {
   template <typename T>
   static node& convert_to_node(const T& rhs, shared_memory_holder pMemory);
 
+  template <typename Key>
+  node* find_map_value(const Key& key, const shared_memory_holder& pMemory,
+                       std::false_type) const;
+  template <typename Key>
+  node* find_map_value(const Key& key, const shared_memory_holder& pMemory,
+                       std::true_type) const;
+
+  node* find_map_key(const char* key, std::size_t size) const;
+  bool is_map_indexed() const;
+  void index_map_keys();
+  void clear_map_index();
+
  private:
   bool m_isDefined;
   Mark m_mark;
@@ -120,6 +143,16 @@ class YAML_CPP_API node_data {
   using kv_pair = std::pair<node*, node*>;
   using kv_pairs = std::list<kv_pair>;
   mutable kv_pairs m_undefinedPairs;
+
+  // scalar key index for larger maps, kept up to date as pairs are added
+  // (lookups only read it)
+  std::vector<std::size_t> m_keyIndex;  // m_map position + 1
+  std::size_t m_keyIndexCount;          // m_map entries indexed
+  key_index_epoch m_keyIndexEpoch;      // bumped by the keys when they change
+  std::size_t m_keyIndexBuilt;          // the epoch the index was built at
+
+  // the epochs of the indexed maps this is a key of
+  std::vector<key_index_epoch> m_keyOf;
 };
 }
 }
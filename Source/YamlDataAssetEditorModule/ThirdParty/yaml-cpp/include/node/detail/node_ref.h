@@ -16,7 +16,7 @@ namespace YAML {
 namespace detail {
 class node_ref {
  public:
-  node_ref() : m_pData(new node_data) {}
+  node_ref() : m_pData(std::make_shared<node_data>()) {}
   node_ref(const node_ref&) = delete;
   node_ref& operator=(const node_ref&) = delete;
 
@@ -28,13 +28,28 @@ class node_ref {
   EmitterStyle::value style() const { return m_pData->style(); }
 
   void mark_defined() { m_pData->mark_defined(); }
-  void set_data(const node_ref& rhs) { m_pData = rhs.m_pData; }
+  void set_data(const node_ref& rhs) {
+    if (m_pData->is_map_key()) {
+      rhs.m_pData->mark_map_key(*m_pData);
+      m_pData->map_key_changed();
+    }
+    m_pData = rhs.m_pData;
+  }
+
+  bool is_map_key() const { return m_pData->is_map_key(); }
+  void mark_map_key(const node_data::key_index_epoch& epoch) {
+    m_pData->mark_map_key(epoch);
+  }
+  void mark_map_key(const node_ref& rhs) {
+    m_pData->mark_map_key(*rhs.m_pData);
+  }
+  void map_key_changed() { m_pData->map_key_changed(); }
 
   void set_mark(const Mark& mark) { m_pData->set_mark(mark); }
   void set_type(NodeType::value type) { m_pData->set_type(type); }
   void set_tag(const std::string& tag) { m_pData->set_tag(tag); }
   void set_null() { m_pData->set_null(); }
-  void set_scalar(const std::string& scalar) { m_pData->set_scalar(scalar); }
+  void set_scalar(std::string scalar) { m_pData->set_scalar(std::move(scalar)); }
   void set_style(EmitterStyle::value style) { m_pData->set_style(style); }
 
   // size/iterator
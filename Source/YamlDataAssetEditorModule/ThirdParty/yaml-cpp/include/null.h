@@ -9,6 +9,7 @@
 
 #include "yaml-cpp/include/dll.h"
 #include <string>
+#include <string_view>
 
 namespace YAML {
 class Node;
@@ -18,7 +19,7 @@ inline bool operator==(const _Null&, const _Null&) { return true; }
 inline bool operator!=(const _Null&, const _Null&) { return false; }
 
 YAML_CPP_API bool IsNull(const Node& node);  // old API only
-YAML_CPP_API bool IsNullString(const std::string& str);
+YAML_CPP_API bool IsNullString(std::string_view str);
 
 extern YAML_CPP_API _Null Null;
 }
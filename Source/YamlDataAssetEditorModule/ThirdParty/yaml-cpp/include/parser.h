@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <cstddef>
 #include <ios>
 #include <memory>
 
@@ -39,6 +40,12 @@ class YAML_CPP_API Parser {
    */
   explicit Parser(std::istream& in);
 
+  /**
+   * Constructs a parser from the given buffer, which is read in place (not
+   * copied). The buffer must live as long as the parser.
+   */
+  Parser(const char* data, std::size_t size);
+
   ~Parser();
 
   /** Evaluates to true if the parser has some valid input to be read. */
@@ -50,6 +57,11 @@ class YAML_CPP_API Parser {
    */
   void Load(std::istream& in);
 
+  /**
+   * Resets the parser with the given buffer. Any existing state is erased.
+   */
+  void Load(const char* data, std::size_t size);
+
   /**
    * Handles the next document by calling events on the {@code eventHandler}.
    *
@@ -680,22 +680,17 @@ void Emitter::SpaceOrIndentTo(bool requireSpace, std::size_t indent) {
   m_stream << IndentTo(indent);
 }
 
-void Emitter::PrepareIntegralStream(std::stringstream& stream) const {
-
+int Emitter::GetIntegralBase() const {
   switch (m_pState->GetIntFormat()) {
     case Dec:
-      stream << std::dec;
-      break;
+      return 10;
     case Hex:
-      stream << "0x";
-      stream << std::hex;
-      break;
+      return 16;
     case Oct:
-      stream << "0";
-      stream << std::oct;
-      break;
+      return 8;
     default:
       assert(false);
+      return 10;
   }
 }
 
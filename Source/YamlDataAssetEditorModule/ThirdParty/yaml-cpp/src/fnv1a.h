@@ -0,0 +1,27 @@
+#ifndef FNV1A_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define FNV1A_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+namespace YAML {
+namespace detail {
+// FNV-1a, for the hash tables keyed by scalar text
+inline std::size_t fnv1a(const char* data, std::size_t size) {
+  std::uint64_t hash = 14695981039346656037ull;
+  for (std::size_t i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ull;
+  }
+  return static_cast<std::size_t>(hash);
+}
+}  // namespace detail
+}  // namespace YAML
+
+#endif  // FNV1A_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -1,6 +1,7 @@
 #include "yaml-cpp/include/fptostring.h"
 #include "contrib/dragonbox.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
@@ -69,12 +70,14 @@ int ConvertToChars(char* begin, char* end, size_t value, int width=1) {
 }
 
 /**
- * Converts a float or double to a string.
+ * Converts a float or double to chars.
  *
- * converts a value 'v' to a string. Uses dragonbox for formatting.
+ * writes value 'v' to 'out', which must have room for max(precision, 24) + 8 chars. Uses
+ * dragonbox for formatting.
+ * @return          - the end of what was written (or nullptr if it can't be formatted this way)
  */
 template <typename T>
-std::string FpToString(T v, int precision = 0) {
+char* FpToChars(char* out, T v, int precision = 0) {
   // hard coded constant, at which exponent should switch to a scientific notation
   int const lowerExponentThreshold = -5;
   int const upperExponentThreshold =  (precision==0)?6:precision;
@@ -83,11 +86,15 @@ std::string FpToString(T v, int precision = 0) {
   }
 
   // dragonbox/to_decimal does not handle value 0, inf, NaN
-  if (v == 0 || std::isinf(v) || std::isnan(v)) {
-    std::stringstream ss;
-    ss.imbue(std::locale("C"));
-    ss << v;
-    return ss.str();
+  if (v == 0) {
+    if (std::signbit(v)) {
+      *(out++) = '-';
+    }
+    *(out++) = '0';
+    return out;
+  }
+  if (std::isinf(v) || std::isnan(v)) {
+    return nullptr;
   }
 
   auto r = jkj::dragonbox::to_decimal(v);
@@ -97,10 +104,7 @@ std::string FpToString(T v, int precision = 0) {
 
   // defensive programming, ConvertToChars arguments are invalid
   if (digits_ct == -1) {
-    std::stringstream ss;
-    ss.imbue(std::locale("C"));
-    ss << v;
-    return ss.str();
+    return nullptr;
   }
 
   // check if requested precision is lower than
@@ -129,8 +133,7 @@ std::string FpToString(T v, int precision = 0) {
     }
   }
 
-  std::array<char, 28> output_buffer; // max digits of size_t plus sign, a dot and 2 letters for 'e+' or 'e-' and 4 letters for the exponent
-  auto output_ptr = &output_buffer[0];
+  auto output_ptr = out;
 
   // print '-' symbol for negative numbers
   if (r.is_negative) {
@@ -160,10 +163,7 @@ std::string FpToString(T v, int precision = 0) {
 
     // defensive programming, ConvertToChars arguments are invalid
     if (exp_digits_ct == -1) {
-      std::stringstream ss;
-      ss.imbue(std::locale("C"));
-      ss << v;
-      return ss.str();
+      return nullptr;
     }
 
     for (int i{0}; i < exp_digits_ct; ++i) {
@@ -206,8 +206,47 @@ std::string FpToString(T v, int precision = 0) {
       }
     }
   }
-  *output_ptr = '\0';
-  return std::string{&output_buffer[0], output_ptr};
+  return output_ptr;
+}
+
+/**
+ * Converts a value to a string with a stream, for the values dragonbox doesn't handle.
+ */
+template <typename T>
+std::string StreamToString(T v, size_t precision = 0) {
+  std::stringstream ss;
+  ss.imbue(std::locale("C"));
+  if (precision != 0) {
+    ss.precision(precision);
+  }
+  ss << v;
+  return ss.str();
+}
+
+template <typename T>
+std::string FpToString(T v, size_t precision) {
+  std::string str(std::max<size_t>(precision, 24) + 8, '\0');
+  auto end = FpToChars(&str[0], v, static_cast<int>(precision));
+  if (end == nullptr) {
+    return StreamToString(v);
+  }
+  str.resize(end - &str[0]);
+  return str;
+}
+
+template <typename T>
+char* FpToBuffer(char* buffer, T v, size_t precision) {
+  // (any more than fits the buffer would only change when to switch to scientific notation)
+  if (precision > FpToCharsSize - 8) {
+    precision = FpToCharsSize - 8;
+  }
+
+  auto end = FpToChars(buffer, v, static_cast<int>(precision));
+  if (end == nullptr) {
+    auto str = StreamToString(v);
+    end = std::copy_n(str.data(), std::min(str.size(), FpToCharsSize), buffer);
+  }
+  return end;
 }
 
 }
@@ -221,18 +260,27 @@ std::string FpToString(double v, size_t precision) {
   return detail::fp_formatting::FpToString(v, precision);
 }
 
+char* FpToChars(char* buffer, float v, size_t precision) {
+  return detail::fp_formatting::FpToBuffer(buffer, v, precision);
+}
+
+char* FpToChars(char* buffer, double v, size_t precision) {
+  return detail::fp_formatting::FpToBuffer(buffer, v, precision);
+}
+
 /**
  * dragonbox only works for floats/doubles not long double
  */
 std::string FpToString(long double v, size_t precision) {
-  std::stringstream ss;
-  ss.imbue(std::locale("C"));
   if (precision == 0) {
      precision = std::numeric_limits<long double>::max_digits10;
   }
-  ss.precision(precision);
-  ss << v;
-  return ss.str();
+  return detail::fp_formatting::StreamToString(v, precision);
+}
+
+char* FpToChars(char* buffer, long double v, size_t precision) {
+  auto str = FpToString(v, precision);
+  return std::copy_n(str.data(), std::min(str.size(), FpToCharsSize), buffer);
 }
 
 }
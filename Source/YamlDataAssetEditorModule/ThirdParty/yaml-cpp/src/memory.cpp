@@ -2,9 +2,54 @@
 #include "yaml-cpp/include/node/detail/node.h"  // IWYU pragma: keep
 #include "yaml-cpp/include/node/ptr.h"
 
+#include <algorithm>
+#include <new>
+
+#ifndef YAML_NODE_BLOCK_MIN
+#define YAML_NODE_BLOCK_MIN 16
+#endif
+
+#ifndef YAML_NODE_BLOCK_MAX
+#define YAML_NODE_BLOCK_MAX 1024
+#endif
+
 namespace YAML {
 namespace detail {
 
+// block
+// . Storage for a number of nodes, which are constructed in order and all
+//   destroyed with the block
+class memory::block {
+ public:
+  explicit block(std::size_t capacity)
+      : m_pNodes(std::allocator<node>().allocate(capacity)),
+        m_size(0),
+        m_capacity(capacity) {}
+
+  block(const block&) = delete;
+  block& operator=(const block&) = delete;
+
+  ~block() {
+    for (std::size_t i = 0; i < m_size; i++)
+      m_pNodes[i].~node();
+    std::allocator<node>().deallocate(m_pNodes, m_capacity);
+  }
+
+  bool full() const { return m_size == m_capacity; }
+  std::size_t capacity() const { return m_capacity; }
+
+  node& create_node() {
+    node* pNode = new (m_pNodes + m_size) node;
+    m_size++;
+    return *pNode;
+  }
+
+ private:
+  node* m_pNodes;
+  std::size_t m_size;
+  std::size_t m_capacity;
+};
+
 void memory_holder::merge(memory_holder& rhs) {
   if (m_pMemory == rhs.m_pMemory)
     return;
@@ -14,13 +59,22 @@ void memory_holder::merge(memory_holder& rhs) {
 }
 
 node& memory::create_node() {
-  shared_node pNode(new node);
-  m_nodes.insert(pNode);
-  return *pNode;
+  if (!m_pCurrent || m_pCurrent->full()) {
+    // grow the blocks as we go, so a small node doesn't cost a large block
+    std::size_t capacity =
+        m_pCurrent ? std::min<std::size_t>(m_pCurrent->capacity() * 2,
+                                           YAML_NODE_BLOCK_MAX)
+                   : YAML_NODE_BLOCK_MIN;
+    std::shared_ptr<block> pBlock = std::make_shared<block>(capacity);
+    m_blocks.insert(pBlock);
+    m_pCurrent = pBlock.get();
+  }
+
+  return m_pCurrent->create_node();
 }
 
 void memory::merge(const memory& rhs) {
-  m_nodes.insert(rhs.m_nodes.begin(), rhs.m_nodes.end());
+  m_blocks.insert(rhs.m_blocks.begin(), rhs.m_blocks.end());
 }
 }  // namespace detail
 }  // namespace YAML
@@ -1,9 +1,11 @@
 #include "yaml-cpp/include/node/detail/node_data.h"
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iterator>
 #include <sstream>
 
+#include "fnv1a.h"
 #include "yaml-cpp/include/exceptions.h"
 #include "yaml-cpp/include/node/detail/memory.h"
 #include "yaml-cpp/include/node/detail/node.h"  // IWYU pragma: keep
@@ -15,6 +17,28 @@ namespace YAML {
 namespace detail {
 YAML_CPP_API std::atomic<size_t> node::m_amount{0};
 
+#ifndef YAML_MAP_INDEX_MIN
+#define YAML_MAP_INDEX_MIN 16
+#endif
+
+// a key remembers the epochs of the indexed maps it's in and bumps them when it
+// changes, so only those maps stop using their index (keys don't normally
+// change once they're in a map)
+void node_data::mark_map_key(const key_index_epoch& epoch) {
+  if (std::find(m_keyOf.begin(), m_keyOf.end(), epoch) == m_keyOf.end())
+    m_keyOf.push_back(epoch);
+}
+
+void node_data::mark_map_key(const node_data& rhs) {
+  for (const key_index_epoch& epoch : rhs.m_keyOf)
+    mark_map_key(epoch);
+}
+
+void node_data::map_key_changed() {
+  for (const key_index_epoch& epoch : m_keyOf)
+    ++*epoch;
+}
+
 const std::string& node_data::empty_scalar() {
   static const std::string svalue;
   return svalue;
@@ -30,9 +54,16 @@ node_data::node_data()
       m_sequence{},
       m_seqSize(0),
       m_map{},
-      m_undefinedPairs{} {}
+      m_undefinedPairs{},
+      m_keyIndex{},
+      m_keyIndexCount(0),
+      m_keyIndexEpoch{},
+      m_keyIndexBuilt(0),
+      m_keyOf{} {}
 
 void node_data::mark_defined() {
+  if (is_map_key() && !m_isDefined)
+    map_key_changed();
   if (m_type == NodeType::Undefined)
     m_type = NodeType::Null;
   m_isDefined = true;
@@ -41,6 +72,9 @@ void node_data::mark_defined() {
 void node_data::set_mark(const Mark& mark) { m_mark = mark; }
 
 void node_data::set_type(NodeType::value type) {
+  if (is_map_key())
+    map_key_changed();
+
   if (type == NodeType::Undefined) {
     m_type = type;
     m_isDefined = false;
@@ -76,14 +110,18 @@ void node_data::set_tag(const std::string& tag) { m_tag = tag; }
 void node_data::set_style(EmitterStyle::value style) { m_style = style; }
 
 void node_data::set_null() {
+  if (is_map_key())
+    map_key_changed();
   m_isDefined = true;
   m_type = NodeType::Null;
 }
 
-void node_data::set_scalar(const std::string& scalar) {
+void node_data::set_scalar(std::string scalar) {
+  if (is_map_key())
+    map_key_changed();
   m_isDefined = true;
   m_type = NodeType::Scalar;
-  m_scalar = scalar;
+  m_scalar = std::move(scalar);
 }
 
 // size/iterator
@@ -263,12 +301,95 @@ bool node_data::remove(node& key, const shared_memory_holder& /* pMemory */) {
 
   if (it != m_map.end()) {
     m_map.erase(it);
+    clear_map_index();
     return true;
   }
 
   return false;
 }
 
+// find_map_key
+// . Finds the value for a scalar key, the same as comparing each key with
+//   node::equals (but without converting it to a string)
+node* node_data::find_map_key(const char* key, std::size_t size) const {
+  auto matches = [&](const node& k) {
+    return k.type() == NodeType::Scalar && k.scalar().size() == size &&
+           std::memcmp(k.scalar().data(), key, size) == 0;
+  };
+
+  // small maps aren't indexed, and a map whose keys were changed in place
+  // isn't either until its next non-const access (this doesn't modify the
+  // map, so a const node can be read from several threads)
+  if (!is_map_indexed()) {
+    for (const kv_pair& kv : m_map) {
+      if (matches(*kv.first))
+        return kv.second;
+    }
+    return nullptr;
+  }
+
+  const std::size_t mask = m_keyIndex.size() - 1;
+  for (std::size_t i = fnv1a(key, size) & mask; m_keyIndex[i] != 0;
+       i = (i + 1) & mask) {
+    const kv_pair& kv = m_map[m_keyIndex[i] - 1];
+    if (matches(*kv.first))
+      return kv.second;
+  }
+
+  return nullptr;
+}
+
+bool node_data::is_map_indexed() const {
+  return m_keyIndexEpoch && m_keyIndexCount == m_map.size() &&
+         *m_keyIndexEpoch == m_keyIndexBuilt;
+}
+
+// index_map_keys
+// . Brings the key index of a larger map up to date, adding any new pairs (or
+//   rebuilding it if it's too small or a key has changed)
+void node_data::index_map_keys() {
+  if (m_map.size() < YAML_MAP_INDEX_MIN)
+    return;
+
+  if (!m_keyIndexEpoch)
+    m_keyIndexEpoch = std::make_shared<std::size_t>(0);
+
+  if (*m_keyIndexEpoch != m_keyIndexBuilt || m_keyIndexCount > m_map.size() ||
+      m_keyIndex.size() < m_map.size() * 2) {
+    std::size_t capacity = 32;
+    while (capacity < m_map.size() * 4)
+      capacity *= 2;
+
+    m_keyIndex.assign(capacity, 0);
+    m_keyIndexCount = 0;
+    m_keyIndexBuilt = *m_keyIndexEpoch;
+  }
+
+  const std::size_t mask = m_keyIndex.size() - 1;
+  for (; m_keyIndexCount < m_map.size(); m_keyIndexCount++) {
+    node& k = *m_map[m_keyIndexCount].first;
+    k.mark_map_key(m_keyIndexEpoch);
+    if (k.type() != NodeType::Scalar)
+      continue;
+
+    // the first of any duplicates wins, like a linear search
+    const std::string& scalar = k.scalar();
+    std::size_t i = fnv1a(scalar.data(), scalar.size()) & mask;
+    while (m_keyIndex[i] != 0 &&
+           m_map[m_keyIndex[i] - 1].first->scalar() != scalar)
+      i = (i + 1) & mask;
+
+    if (m_keyIndex[i] == 0)
+      m_keyIndex[i] = m_keyIndexCount + 1;
+  }
+}
+
+void node_data::clear_map_index() {
+  m_keyIndex.clear();
+  m_keyIndexCount = 0;
+  index_map_keys();
+}
+
 void node_data::reset_sequence() {
   m_sequence.clear();
   m_seqSize = 0;
@@ -277,10 +398,12 @@ void node_data::reset_sequence() {
 void node_data::reset_map() {
   m_map.clear();
   m_undefinedPairs.clear();
+  clear_map_index();
 }
 
 void node_data::insert_map_pair(node& key, node& value) {
   m_map.emplace_back(&key, &value);
+  index_map_keys();
 
   if (!key.is_defined() || !value.is_defined())
     m_undefinedPairs.emplace_back(&key, &value);
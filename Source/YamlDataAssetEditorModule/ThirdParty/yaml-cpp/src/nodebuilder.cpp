@@ -46,8 +46,13 @@ void NodeBuilder::OnAlias(const Mark& /* mark */, anchor_t anchor) {
 
 void NodeBuilder::OnScalar(const Mark& mark, const std::string& tag,
                            anchor_t anchor, const std::string& value) {
+  OnScalarView(mark, tag, anchor, value);
+}
+
+void NodeBuilder::OnScalarView(const Mark& mark, const std::string& tag,
+                               anchor_t anchor, std::string_view value) {
   detail::node& node = Push(mark, anchor);
-  node.set_scalar(value);
+  node.set_scalar(std::string(value));
   node.set_tag(tag);
   Pop();
 }
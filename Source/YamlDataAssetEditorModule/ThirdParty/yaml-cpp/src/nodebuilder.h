@@ -42,6 +42,8 @@ class NodeBuilder : public EventHandler {
   void OnAlias(const Mark& mark, anchor_t anchor) override;
   void OnScalar(const Mark& mark, const std::string& tag,
                         anchor_t anchor, const std::string& value) override;
+  void OnScalarView(const Mark& mark, const std::string& tag,
+                    anchor_t anchor, std::string_view value) override;
 
   void OnSequenceStart(const Mark& mark, const std::string& tag,
                                anchor_t anchor, EmitterStyle::value style) override;
@@ -3,7 +3,7 @@
 namespace YAML {
 _Null Null;
 
-bool IsNullString(const std::string& str) {
+bool IsNullString(std::string_view str) {
   return str.empty() || str == "~" || str == "null" || str == "Null" ||
          str == "NULL";
 }
@@ -19,6 +19,16 @@ Node Load(const char* input) {
   return Load(stream);
 }
 
+Node Load(const char* input, std::size_t size) {
+  Parser parser(input, size);
+  NodeBuilder builder;
+  if (!parser.HandleNextDocument(builder)) {
+    return Node();
+  }
+
+  return builder.Root();
+}
+
 Node Load(std::istream& input) {
   Parser parser(input);
   NodeBuilder builder;
@@ -47,6 +57,21 @@ std::vector<Node> LoadAll(const char* input) {
   return LoadAll(stream);
 }
 
+std::vector<Node> LoadAll(const char* input, std::size_t size) {
+  std::vector<Node> docs;
+
+  Parser parser(input, size);
+  while (true) {
+    NodeBuilder builder;
+    if (!parser.HandleNextDocument(builder) || builder.Root().IsNull()) {
+      break;
+    }
+    docs.push_back(builder.Root());
+  }
+
+  return docs;
+}
+
 std::vector<Node> LoadAll(std::istream& input) {
   std::vector<Node> docs;
 
@@ -15,6 +15,10 @@ Parser::Parser() : m_pScanner{}, m_pDirectives{} {}
 
 Parser::Parser(std::istream& in) : Parser() { Load(in); }
 
+Parser::Parser(const char* data, std::size_t size) : Parser() {
+  Load(data, size);
+}
+
 Parser::~Parser() = default;
 
 Parser::operator bool() const { return m_pScanner && !m_pScanner->empty(); }
@@ -24,6 +28,11 @@ void Parser::Load(std::istream& in) {
   m_pDirectives.reset(new Directives);
 }
 
+void Parser::Load(const char* data, std::size_t size) {
+  m_pScanner.reset(new Scanner(data, size));
+  m_pDirectives.reset(new Directives);
+}
+
 bool Parser::HandleNextDocument(EventHandler& eventHandler) {
   if (!m_pScanner)
     return false;
@@ -6,17 +6,24 @@ namespace YAML {
 RegEx::RegEx(REGEX_OP op) : m_op(op), m_a(0), m_z(0), m_params{} {}
 RegEx::RegEx() : RegEx(REGEX_EMPTY) {}
 
-RegEx::RegEx(char ch) : m_op(REGEX_MATCH), m_a(ch), m_z(0), m_params{} {}
+RegEx::RegEx(char ch) : m_op(REGEX_MATCH), m_a(ch), m_z(0), m_params{} {
+  Compile();
+}
 
-RegEx::RegEx(char a, char z) : m_op(REGEX_RANGE), m_a(a), m_z(z), m_params{} {}
+RegEx::RegEx(char a, char z) : m_op(REGEX_RANGE), m_a(a), m_z(z), m_params{} {
+  Compile();
+}
 
 RegEx::RegEx(const std::string& str, REGEX_OP op)
-    : m_op(op), m_a(0), m_z(0), m_params(str.begin(), str.end()) {}
+    : m_op(op), m_a(0), m_z(0), m_params(str.begin(), str.end()) {
+  Compile();
+}
 
 // combination constructors
 RegEx operator!(const RegEx& ex) {
   RegEx ret(REGEX_NOT);
   ret.m_params.push_back(ex);
+  ret.Compile();
   return ret;
 }
 
@@ -24,6 +31,7 @@ RegEx operator|(const RegEx& ex1, const RegEx& ex2) {
   RegEx ret(REGEX_OR);
   ret.m_params.push_back(ex1);
   ret.m_params.push_back(ex2);
+  ret.Compile();
   return ret;
 }
 
@@ -31,6 +39,7 @@ RegEx operator&(const RegEx& ex1, const RegEx& ex2) {
   RegEx ret(REGEX_AND);
   ret.m_params.push_back(ex1);
   ret.m_params.push_back(ex2);
+  ret.Compile();
   return ret;
 }
 
@@ -38,6 +47,75 @@ RegEx operator+(const RegEx& ex1, const RegEx& ex2) {
   RegEx ret(REGEX_SEQ);
   ret.m_params.push_back(ex1);
   ret.m_params.push_back(ex2);
+  ret.Compile();
   return ret;
 }
+
+// Compile
+// . Works out the character table for this expression from its params, see
+//   MatchUnchecked for how it's used.
+void RegEx::Compile() {
+  m_isClass = false;
+  m_hasFirst = false;
+  m_chars.reset();
+
+  switch (m_op) {
+    case REGEX_EMPTY:
+      break;
+    case REGEX_MATCH:
+      m_isClass = true;
+      m_chars.set(static_cast<unsigned char>(m_a));
+      break;
+    case REGEX_RANGE:
+      m_isClass = true;
+      for (int i = 0; i < 256; i++) {
+        char ch = static_cast<char>(i);
+        if (m_a <= ch && ch <= m_z)
+          m_chars.set(static_cast<unsigned char>(i));
+      }
+      break;
+    case REGEX_OR:
+      // any of the params, so we need a table for all of them
+      m_isClass = true;
+      m_hasFirst = true;
+      for (const RegEx& param : m_params) {
+        m_isClass = m_isClass && param.m_isClass;
+        m_hasFirst = m_hasFirst && param.m_hasFirst;
+        m_chars |= param.m_chars;
+      }
+      break;
+    case REGEX_AND:
+      // all of the params, so any tables narrow it down
+      if (m_params.empty())
+        break;
+      m_isClass = true;
+      m_chars.set();
+      for (const RegEx& param : m_params) {
+        m_isClass = m_isClass && param.m_isClass;
+        if (param.m_hasFirst) {
+          m_hasFirst = true;
+          m_chars &= param.m_chars;
+        }
+      }
+      break;
+    case REGEX_NOT:
+      if (!m_params.empty() && m_params[0].m_isClass) {
+        m_isClass = true;
+        m_chars = ~m_params[0].m_chars;
+      }
+      break;
+    case REGEX_SEQ:
+      // has to start with the first param
+      if (!m_params.empty() && m_params[0].m_hasFirst) {
+        m_hasFirst = true;
+        m_chars = m_params[0].m_chars;
+      }
+      break;
+  }
+
+  if (m_isClass)
+    m_hasFirst = true;
+  else if (!m_hasFirst)
+    m_chars.reset();
+}
 }  // namespace YAML
@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <bitset>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,9 @@ enum REGEX_OP {
 // simplified regular expressions
 // . Only straightforward matches (no repeated characters)
 // . Only matches from start of string
+// . Each expression is compiled to a 256 entry character table when it is
+//   built, so single character classes (however they were combined) are a
+//   lookup, and anything else can reject on the first character
 class YAML_CPP_API RegEx {
  public:
   RegEx();
@@ -47,6 +51,11 @@ class YAML_CPP_API RegEx {
   template <typename Source>
   bool Matches(const Source& source) const;
 
+  // the characters a match has to start with (nullptr if it's not known)
+  const std::bitset<256>* FirstChars() const {
+    return m_hasFirst ? &m_chars : nullptr;
+  }
+
   int Match(const std::string& str) const;
   int Match(const Stream& in) const;
   template <typename Source>
@@ -55,6 +64,8 @@ class YAML_CPP_API RegEx {
  private:
   explicit RegEx(REGEX_OP op);
 
+  void Compile();
+
   template <typename Source>
   bool IsValidSource(const Source& source) const;
   template <typename Source>
@@ -80,6 +91,10 @@ class YAML_CPP_API RegEx {
   char m_a{};
   char m_z{};
   std::vector<RegEx> m_params;
+
+  bool m_isClass{};   // matches exactly one character, iff it's in m_chars
+  bool m_hasFirst{};  // can only match if the first character is in m_chars
+  std::bitset<256> m_chars;
 };
 }  // namespace YAML
 
@@ -14,6 +14,9 @@
 namespace YAML {
 // query matches
 inline bool RegEx::Matches(char ch) const {
+  if (m_isClass)
+    return m_chars[static_cast<unsigned char>(ch)];
+
   std::string str;
   str += ch;
   return Matches(str);
@@ -71,6 +74,15 @@ inline int RegEx::Match(const Source& source) const {
 
 template <typename Source>
 inline int RegEx::MatchUnchecked(const Source& source) const {
+  // the compiled table gives the same answer as the operators below, which
+  // (unchecked) look at source[0] in the same way
+  if (m_hasFirst) {
+    if (!m_chars[static_cast<unsigned char>(source[0])])
+      return -1;
+    if (m_isClass)
+      return 1;
+  }
+
   switch (m_op) {
     case REGEX_EMPTY:
       return MatchOpEmpty(source);
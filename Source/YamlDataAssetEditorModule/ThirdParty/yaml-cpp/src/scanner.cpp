@@ -10,6 +10,7 @@ namespace YAML {
 Scanner::Scanner(std::istream& in)
     : INPUT(in),
       m_tokens{},
+      m_scalar{},
       m_startedStream(false),
       m_endedStream(false),
       m_simpleKeyAllowed(false),
@@ -17,7 +18,23 @@ Scanner::Scanner(std::istream& in)
       m_canBeJSONFlow(false),
       m_simpleKeys{},
       m_indents{},
-      m_indentRefs{},
+      m_indentPool{},
+      m_indentPoolUsed(0),
+      m_flows{} {}
+
+Scanner::Scanner(const char* data, std::size_t size)
+    : INPUT(data, size),
+      m_tokens{},
+      m_scalar{},
+      m_startedStream(false),
+      m_endedStream(false),
+      m_simpleKeyAllowed(false),
+      m_scalarValueAllowed(false),
+      m_canBeJSONFlow(false),
+      m_simpleKeys{},
+      m_indents{},
+      m_indentPool{},
+      m_indentPoolUsed(0),
       m_flows{} {}
 
 Scanner::~Scanner() = default;
@@ -268,10 +285,9 @@ void Scanner::StartStream() {
   m_startedStream = true;
   m_simpleKeyAllowed = true;
   m_scalarValueAllowed = true;
-  std::unique_ptr<IndentMarker> pIndent(
-      new IndentMarker(-1, IndentMarker::NONE));
-  m_indentRefs.push_back(std::move(pIndent));
-  m_indents.push(&m_indentRefs.back());
+  m_indentPool.emplace_back(-1, IndentMarker::NONE);
+  m_indentPoolUsed = 1;
+  m_indents.push(&m_indentPool.front());
 }
 
 void Scanner::EndStream() {
@@ -289,8 +305,7 @@ void Scanner::EndStream() {
 }
 
 Token* Scanner::PushToken(Token::TYPE type) {
-  m_tokens.push(Token(type, INPUT.mark()));
-  return &m_tokens.back();
+  return &m_tokens.push(type, INPUT.mark());
 }
 
 Token::TYPE Scanner::GetStartTokenFor(IndentMarker::INDENT_TYPE type) const {
@@ -314,27 +329,31 @@ Scanner::IndentMarker* Scanner::PushIndentTo(int column,
     return nullptr;
   }
 
-  std::unique_ptr<IndentMarker> pIndent(new IndentMarker(column, type));
-  IndentMarker& indent = *pIndent;
   const IndentMarker& lastIndent = *m_indents.top();
 
   // is this actually an indentation?
-  if (indent.column < lastIndent.column) {
+  if (column < lastIndent.column) {
     return nullptr;
   }
-  if (indent.column == lastIndent.column &&
-      !(indent.type == IndentMarker::SEQ &&
-        lastIndent.type == IndentMarker::MAP)) {
+  if (column == lastIndent.column &&
+      !(type == IndentMarker::SEQ && lastIndent.type == IndentMarker::MAP)) {
     return nullptr;
   }
 
+  // take a marker from the pool
+  if (m_indentPoolUsed == m_indentPool.size()) {
+    m_indentPool.emplace_back(column, type);
+  } else {
+    m_indentPool[m_indentPoolUsed] = IndentMarker(column, type);
+  }
+  IndentMarker& indent = m_indentPool[m_indentPoolUsed++];
+
   // push a start token
   indent.pStartToken = PushToken(GetStartTokenFor(type));
 
   // and then the indent
   m_indents.push(&indent);
-  m_indentRefs.push_back(std::move(pIndent));
-  return &m_indentRefs.back();
+  return &indent;
 }
 
 void Scanner::PopIndentToHere() {
@@ -391,9 +410,9 @@ void Scanner::PopIndent() {
   }
 
   if (indent.type == IndentMarker::SEQ) {
-    m_tokens.push(Token(Token::BLOCK_SEQ_END, INPUT.mark()));
+    m_tokens.push(Token::BLOCK_SEQ_END, INPUT.mark());
   } else if (indent.type == IndentMarker::MAP) {
-    m_tokens.push(Token(Token::BLOCK_MAP_END, INPUT.mark()));
+    m_tokens.push(Token::BLOCK_MAP_END, INPUT.mark());
   }
 }
 
@@ -404,6 +423,13 @@ int Scanner::GetTopIndent() const {
   return m_indents.top()->column;
 }
 
+void Scanner::ResetIndentPool() {
+  // simple keys point at their indents too
+  if (m_indents.size() == 1 && m_simpleKeys.empty()) {
+    m_indentPoolUsed = 1;
+  }
+}
+
 void Scanner::ThrowParserException(const std::string& msg) const {
   Mark mark = Mark::null_mark();
   if (!m_tokens.empty()) {
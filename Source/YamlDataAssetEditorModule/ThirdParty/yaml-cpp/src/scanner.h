@@ -8,14 +8,14 @@
 #endif
 
 #include <cstddef>
+#include <deque>
 #include <ios>
-#include <queue>
 #include <stack>
 #include <string>
 
-#include "ptr_vector.h"
 #include "stream.h"
 #include "token.h"
+#include "tokenqueue.h"
 #include "yaml-cpp/include/mark.h"
 
 namespace YAML {
@@ -28,6 +28,7 @@ class RegEx;
 class Scanner {
  public:
   explicit Scanner(std::istream &in);
+  Scanner(const char *data, std::size_t size);
   ~Scanner();
 
   /** Returns true if there are no more tokens to be read. */
@@ -115,6 +116,12 @@ class Scanner {
   void PopIndent();
   int GetTopIndent() const;
 
+  /**
+   * Returns the indent markers to the pool, if nothing refers to them (i.e.
+   * between documents).
+   */
+  void ResetIndentPool();
+
   // checking input
   bool CanInsertPotentialSimpleKey() const;
   bool ExistsActiveSimpleKey() const;
@@ -172,7 +179,8 @@ class Scanner {
   Stream INPUT;
 
   // the output (tokens)
-  std::queue<Token> m_tokens;
+  TokenQueue m_tokens;
+  std::string m_scalar;  // reused for scanning scalars
 
   // state info
   bool m_startedStream, m_endedStream;
@@ -181,7 +189,8 @@ class Scanner {
   bool m_canBeJSONFlow;
   std::stack<SimpleKey> m_simpleKeys;
   std::stack<IndentMarker *> m_indents;
-  ptr_vector<IndentMarker> m_indentRefs;  // for "garbage collection"
+  std::deque<IndentMarker> m_indentPool;  // [0] is the base NONE indent
+  std::size_t m_indentPoolUsed;
   std::stack<FLOW_MARKER> m_flows;
 };
 }
@@ -1,6 +1,14 @@
 #include "scanscalar.h"
 
 #include <algorithm>
+#include <bitset>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YAML_SCAN_SSE2 1
+#endif
 
 #include "exp.h"
 #include "regeximpl.h"
@@ -8,6 +16,168 @@
 #include "yaml-cpp/include/exceptions.h"  // IWYU pragma: keep
 
 namespace YAML {
+namespace {
+// characters that can never stop a run (letters, digits and any utf-8 byte
+// above 0x7F), which is what the vector loop in FindRunStop skips over
+std::bitset<256> MakeRunChars() {
+  std::bitset<256> chars;
+  for (int i = 0; i < 256; i++) {
+    if ((i >= 'a' && i <= 'z') || (i >= 'A' && i <= 'Z') ||
+        (i >= '0' && i <= '9') || i >= 0x80)
+      chars.set(i);
+  }
+  return chars;
+}
+
+// RunStops
+// . The characters that need the full checks in phase #1 of ScanScalar, i.e.
+//   anything that might end the scalar, a line break or an escape. Everything
+//   else can be copied to the scalar as it is.
+struct RunStops {
+  std::bitset<256> chars;
+  bool vector;  // can use the vector loop
+  bool space;   // spaces aren't a stop either
+
+  explicit RunStops(const ScanScalarParams& params) : vector(false), space(false) {
+    if (params.end == &Exp::Empty()) {
+      chars.set(static_cast<unsigned char>(Stream::eof()));
+    } else if (const std::bitset<256>* first = params.end->FirstChars()) {
+      chars = *first;
+    } else {
+      chars.set();
+      return;
+    }
+
+    // (and nul, which Stream::get can treat as a line ending)
+    chars.set('\n');
+    chars.set('\r');
+    chars.set(0);
+    chars.set(static_cast<unsigned char>(params.escape));
+    chars.set(static_cast<unsigned char>(Stream::eof()));
+
+    static const std::bitset<256> runChars = MakeRunChars();
+    vector = (chars & runChars).none();
+    space = !chars.test(' ');
+  }
+};
+
+// FindRunStop
+// . Returns the length of the run of characters before the next stop
+std::size_t FindRunStop(const char* str, std::size_t size,
+                        const RunStops& stops) {
+  std::size_t i = 0;
+
+#ifdef YAML_SCAN_SSE2
+  if (stops.vector) {
+    const __m128i lower = _mm_set1_epi8(0x20);
+    const __m128i a = _mm_set1_epi8('a' - 1);
+    const __m128i z = _mm_set1_epi8('z' + 1);
+    const __m128i d0 = _mm_set1_epi8('0' - 1);
+    const __m128i d9 = _mm_set1_epi8('9' + 1);
+    const __m128i space = _mm_set1_epi8(stops.space ? ' ' : 'a');
+    const __m128i zero = _mm_setzero_si128();
+
+    while (i + 16 <= size) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+      __m128i l = _mm_or_si128(v, lower);
+      __m128i run = _mm_or_si128(
+          _mm_or_si128(_mm_cmplt_epi8(v, zero),
+                       _mm_and_si128(_mm_cmpgt_epi8(l, a), _mm_cmplt_epi8(l, z))),
+          _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(v, d0), _mm_cmplt_epi8(v, d9)),
+                       _mm_cmpeq_epi8(v, space)));
+
+      if (_mm_movemask_epi8(run) != 0xFFFF) {
+        // something else in this block, so check it one at a time
+        for (std::size_t end = i + 16; i < end; i++) {
+          if (stops.chars[static_cast<unsigned char>(str[i])])
+            return i;
+        }
+        continue;
+      }
+
+      i += 16;
+    }
+  }
+#endif
+
+  for (; i < size; i++) {
+    if (stops.chars[static_cast<unsigned char>(str[i])])
+      break;
+  }
+
+  return i;
+}
+
+// ScalarText
+// . The scalar as it is scanned. While everything added to it is the next
+//   slice of an in-memory input it only remembers where that is, it is copied
+//   into the output string the first time anything else is added (an escape,
+//   a folded line break, etc).
+class ScalarText {
+ public:
+  ScalarText(std::string& str, bool canView) : m_viewing(canView), m_str(str) {
+    m_str.clear();
+  }
+
+  std::size_t size() const { return m_viewing ? m_viewSize : m_str.size(); }
+  std::string_view text() const {
+    return m_viewing ? std::string_view(m_view, m_viewSize) : m_str;
+  }
+  bool viewing() const { return m_viewing; }
+
+  // n characters that are at str in the input
+  void append_input(const char* str, std::size_t n) {
+    if (m_viewing) {
+      if (m_viewSize == 0) {
+        m_view = str;
+        m_viewSize = n;
+        return;
+      }
+      if (str == m_view + m_viewSize) {
+        m_viewSize += n;
+        return;
+      }
+      own();
+    }
+    m_str.append(str, n);
+  }
+
+  // anything else
+  ScalarText& operator+=(char ch) {
+    own();
+    m_str += ch;
+    return *this;
+  }
+  ScalarText& operator+=(const std::string& str) {
+    own();
+    m_str += str;
+    return *this;
+  }
+
+  // copy it into the output string, if it's still a view
+  void own() {
+    if (m_viewing) {
+      m_str.assign(m_view, m_viewSize);
+      m_viewing = false;
+    }
+  }
+
+  // drop everything from pos on
+  void erase(std::size_t pos = 0) {
+    if (m_viewing)
+      m_viewSize = std::min(pos, m_viewSize);
+    else
+      m_str.erase(pos);
+  }
+
+ private:
+  bool m_viewing;
+  const char* m_view = "";
+  std::size_t m_viewSize = 0;
+  std::string& m_str;
+};
+}  // namespace
+
 // ScanScalar
 // . This is where the scalar magic happens.
 //
@@ -18,20 +188,23 @@ namespace YAML {
 //
 // . Depending on the parameters given, we store or stop
 //   and different places in the above flow.
-std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
+void ScanScalar(Stream& INPUT, ScanScalarParams& params, std::string& out,
+                std::string_view* view) {
   bool foundNonEmptyLine = false;
   bool pastOpeningBreak = (params.fold == FOLD_FLOW);
   bool emptyLine = false, moreIndented = false;
   int foldedNewlineCount = 0;
   bool foldedNewlineStartedMoreIndented = false;
   std::size_t lastEscapedChar = std::string::npos;
-  std::string scalar;
+  ScalarText scalar(out, view != nullptr);
   params.leadingSpaces = false;
 
   if (!params.end) {
     params.end = &Exp::Empty();
   }
 
+  const RunStops stops(params);
+
   while (INPUT) {
     // ********************************
     // Phase #1: scan until line ending
@@ -75,11 +248,32 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
       }
 
       // otherwise, just add the damn character
+      const char* src = INPUT.available() ? INPUT.current() : nullptr;
       char ch = INPUT.get();
-      scalar += ch;
+      if (src && INPUT.current() == src + 1)
+        scalar.append_input(src, 1);
+      else
+        scalar += ch;
       if (ch != ' ' && ch != '\t') {
         lastNonWhitespaceChar = scalar.size();
       }
+
+      // along with any that follow it that don't need checking
+      if (std::size_t size = INPUT.available()) {
+        const char* run = INPUT.current();
+        std::size_t n = FindRunStop(run, size, stops);
+        if (n > 0) {
+          scalar.append_input(run, n);
+          INPUT.skip(n);
+
+          std::size_t last = n;
+          while (last > 0 && (run[last - 1] == ' ' || run[last - 1] == '\t'))
+            last--;
+          if (last > 0) {
+            lastNonWhitespaceChar = scalar.size() - (n - last);
+          }
+        }
+      }
     }
 
     // eof? if we're looking to eat something, then we throw
@@ -160,32 +354,32 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
     if (pastOpeningBreak) {
       switch (params.fold) {
         case DONT_FOLD:
-          scalar += "\n";
+          scalar += '\n';
           break;
         case FOLD_BLOCK:
           if (!emptyLine && !nextEmptyLine && !moreIndented &&
               !nextMoreIndented && INPUT.column() >= params.indent) {
-            scalar += " ";
+            scalar += ' ';
           } else if (nextEmptyLine) {
             foldedNewlineCount++;
           } else {
-            scalar += "\n";
+            scalar += '\n';
           }
 
           if (!nextEmptyLine && foldedNewlineCount > 0) {
             scalar += std::string(foldedNewlineCount - 1, '\n');
             if (foldedNewlineStartedMoreIndented ||
                 nextMoreIndented | !foundNonEmptyLine) {
-              scalar += "\n";
+              scalar += '\n';
             }
             foldedNewlineCount = 0;
           }
           break;
         case FOLD_FLOW:
           if (nextEmptyLine) {
-            scalar += "\n";
+            scalar += '\n';
           } else if (!emptyLine && !escapedNewline) {
-            scalar += " ";
+            scalar += ' ';
           }
           break;
       }
@@ -204,7 +398,7 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
 
   // post-processing
   if (params.trimTrailingSpaces) {
-    std::size_t pos = scalar.find_last_not_of(" \t");
+    std::size_t pos = scalar.text().find_last_not_of(" \t");
     if (lastEscapedChar != std::string::npos) {
       if (pos < lastEscapedChar || pos == std::string::npos) {
         pos = lastEscapedChar;
@@ -217,7 +411,7 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
 
   switch (params.chomp) {
     case CLIP: {
-      std::size_t pos = scalar.find_last_not_of('\n');
+      std::size_t pos = scalar.text().find_last_not_of('\n');
       if (lastEscapedChar != std::string::npos) {
         if (pos < lastEscapedChar || pos == std::string::npos) {
           pos = lastEscapedChar;
@@ -230,7 +424,7 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
       }
     } break;
     case STRIP: {
-      std::size_t pos = scalar.find_last_not_of('\n');
+      std::size_t pos = scalar.text().find_last_not_of('\n');
       if (lastEscapedChar != std::string::npos) {
         if (pos < lastEscapedChar || pos == std::string::npos) {
           pos = lastEscapedChar;
@@ -246,6 +440,11 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
       break;
   }
 
-  return scalar;
+  if (view && scalar.viewing()) {
+    *view = scalar.text();
+    return;
+  }
+
+  scalar.own();
 }
 }  // namespace YAML
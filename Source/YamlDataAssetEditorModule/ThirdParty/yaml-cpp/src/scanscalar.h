@@ -8,6 +8,7 @@
 #endif
 
 #include <string>
+#include <string_view>
 
 #include "regex_yaml.h"
 #include "stream.h"
@@ -57,7 +58,14 @@ struct ScanScalarParams {
   bool leadingSpaces;
 };
 
-std::string ScanScalar(Stream& INPUT, ScanScalarParams& params);
+// ScanScalar
+// . The scalar is written to out (replacing what was there, but reusing its
+//   capacity).
+// . If view is given and the scalar turns out to be a single slice of an
+//   in-memory input (nothing unescaped or folded), then it is returned as a
+//   view of the input (valid as long as the stream) and out is left empty.
+void ScanScalar(Stream& INPUT, ScanScalarParams& params, std::string& out,
+                std::string_view* view = nullptr);
 }
 
 #endif  // SCANSCALAR_H_62B23520_7C8E_11DE_8A39_0800200C9A66
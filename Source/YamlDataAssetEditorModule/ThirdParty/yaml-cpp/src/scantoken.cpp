@@ -24,6 +24,7 @@ void Scanner::ScanDirective() {
   // pop indents and simple keys
   PopAllIndents();
   PopAllSimpleKeys();
+  ResetIndentPool();
 
   m_simpleKeyAllowed = false;
   m_canBeJSONFlow = false;
@@ -54,33 +55,35 @@ void Scanner::ScanDirective() {
     token.params.push_back(param);
   }
 
-  m_tokens.push(token);
+  m_tokens.push(std::move(token));
 }
 
 // DocStart
 void Scanner::ScanDocStart() {
   PopAllIndents();
   PopAllSimpleKeys();
+  ResetIndentPool();
   m_simpleKeyAllowed = false;
   m_canBeJSONFlow = false;
 
   // eat
   Mark mark = INPUT.mark();
   INPUT.eat(3);
-  m_tokens.push(Token(Token::DOC_START, mark));
+  m_tokens.push(Token::DOC_START, mark);
 }
 
 // DocEnd
 void Scanner::ScanDocEnd() {
   PopAllIndents();
   PopAllSimpleKeys();
+  ResetIndentPool();
   m_simpleKeyAllowed = false;
   m_canBeJSONFlow = false;
 
   // eat
   Mark mark = INPUT.mark();
   INPUT.eat(3);
-  m_tokens.push(Token(Token::DOC_END, mark));
+  m_tokens.push(Token::DOC_END, mark);
 }
 
 // FlowStart
@@ -97,7 +100,7 @@ void Scanner::ScanFlowStart() {
   m_flows.push(flowType);
   Token::TYPE type =
       (flowType == FLOW_SEQ ? Token::FLOW_SEQ_START : Token::FLOW_MAP_START);
-  m_tokens.push(Token(type, mark));
+  m_tokens.push(type, mark);
 }
 
 // FlowEnd
@@ -108,7 +111,7 @@ void Scanner::ScanFlowEnd() {
   // we might have a solo entry in the flow context
   if (InFlowContext()) {
     if (m_flows.top() == FLOW_MAP && VerifySimpleKey())
-      m_tokens.push(Token(Token::VALUE, INPUT.mark()));
+      m_tokens.push(Token::VALUE, INPUT.mark());
     else if (m_flows.top() == FLOW_SEQ)
       InvalidateSimpleKey();
   }
@@ -127,7 +130,7 @@ void Scanner::ScanFlowEnd() {
   m_flows.pop();
 
   Token::TYPE type = (flowType ? Token::FLOW_SEQ_END : Token::FLOW_MAP_END);
-  m_tokens.push(Token(type, mark));
+  m_tokens.push(type, mark);
 }
 
 // FlowEntry
@@ -135,7 +138,7 @@ void Scanner::ScanFlowEntry() {
   // we might have a solo entry in the flow context
   if (InFlowContext()) {
     if (m_flows.top() == FLOW_MAP && VerifySimpleKey())
-      m_tokens.push(Token(Token::VALUE, INPUT.mark()));
+      m_tokens.push(Token::VALUE, INPUT.mark());
     else if (m_flows.top() == FLOW_SEQ)
       InvalidateSimpleKey();
   }
@@ -146,7 +149,7 @@ void Scanner::ScanFlowEntry() {
   // eat
   Mark mark = INPUT.mark();
   INPUT.eat(1);
-  m_tokens.push(Token(Token::FLOW_ENTRY, mark));
+  m_tokens.push(Token::FLOW_ENTRY, mark);
 }
 
 // BlockEntry
@@ -166,7 +169,7 @@ void Scanner::ScanBlockEntry() {
   // eat
   Mark mark = INPUT.mark();
   INPUT.eat(1);
-  m_tokens.push(Token(Token::BLOCK_ENTRY, mark));
+  m_tokens.push(Token::BLOCK_ENTRY, mark);
 }
 
 // Key
@@ -185,7 +188,7 @@ void Scanner::ScanKey() {
   // eat
   Mark mark = INPUT.mark();
   INPUT.eat(1);
-  m_tokens.push(Token(Token::KEY, mark));
+  m_tokens.push(Token::KEY, mark);
 }
 
 // Value
@@ -217,7 +220,7 @@ void Scanner::ScanValue() {
   // eat
   Mark mark = INPUT.mark();
   INPUT.eat(1);
-  m_tokens.push(Token(Token::VALUE, mark));
+  m_tokens.push(Token::VALUE, mark);
 }
 
 // AnchorOrAlias
@@ -250,9 +253,8 @@ void Scanner::ScanAnchorOrAlias() {
                                               : ErrorMsg::CHAR_IN_ANCHOR);
 
   // and we're done
-  Token token(alias ? Token::ALIAS : Token::ANCHOR, mark);
+  Token& token = m_tokens.push(alias ? Token::ALIAS : Token::ANCHOR, mark);
   token.value = name;
-  m_tokens.push(token);
 }
 
 // Tag
@@ -291,13 +293,11 @@ void Scanner::ScanTag() {
     }
   }
 
-  m_tokens.push(token);
+  m_tokens.push(std::move(token));
 }
 
 // PlainScalar
 void Scanner::ScanPlainScalar() {
-  std::string scalar;
-
   // set up the scanning parameters
   ScanScalarParams params;
   params.end =
@@ -315,7 +315,8 @@ void Scanner::ScanPlainScalar() {
   InsertPotentialSimpleKey();
 
   Mark mark = INPUT.mark();
-  scalar = ScanScalar(INPUT, params);
+  std::string_view view;
+  ScanScalar(INPUT, params, m_scalar, &view);
 
   // can have a simple key only if we ended the scalar by starting a new line
   m_simpleKeyAllowed = params.leadingSpaces;
@@ -325,15 +326,14 @@ void Scanner::ScanPlainScalar() {
   // if(Exp::IllegalCharInScalar.Matches(INPUT))
   //	throw ParserException(INPUT.mark(), ErrorMsg::CHAR_IN_SCALAR);
 
-  Token token(Token::PLAIN_SCALAR, mark);
-  token.value = scalar;
-  m_tokens.push(token);
+  // (swapped so the token's old string is reused for the next scalar)
+  Token& token = m_tokens.push(Token::PLAIN_SCALAR, mark);
+  token.value.swap(m_scalar);
+  token.view = view;
 }
 
 // QuotedScalar
 void Scanner::ScanQuotedScalar() {
-  std::string scalar;
-
   // peek at single or double quote (don't eat because we need to preserve (for
   // the time being) the input position)
   char quote = INPUT.peek();
@@ -361,7 +361,8 @@ void Scanner::ScanQuotedScalar() {
   INPUT.get();
 
   // and scan
-  scalar = ScanScalar(INPUT, params);
+  std::string_view view;
+  ScanScalar(INPUT, params, m_scalar, &view);
   m_simpleKeyAllowed = false;
   // we just scanned a quoted scalar;
   // we can only have another scalar in this line
@@ -369,9 +370,9 @@ void Scanner::ScanQuotedScalar() {
   m_scalarValueAllowed = InFlowContext();
   m_canBeJSONFlow = true;
 
-  Token token(Token::NON_PLAIN_SCALAR, mark);
-  token.value = scalar;
-  m_tokens.push(token);
+  Token& token = m_tokens.push(Token::NON_PLAIN_SCALAR, mark);
+  token.value.swap(m_scalar);
+  token.view = view;
 }
 
 // BlockScalarToken
@@ -380,8 +381,6 @@ void Scanner::ScanQuotedScalar() {
 // of the scalar),
 //   and then we need to figure out what level of indentation we'll be using.
 void Scanner::ScanBlockScalar() {
-  std::string scalar;
-
   ScanScalarParams params;
   params.indent = 1;
   params.detectIndent = true;
@@ -430,15 +429,14 @@ void Scanner::ScanBlockScalar() {
   params.trimTrailingSpaces = false;
   params.onTabInIndentation = THROW;
 
-  scalar = ScanScalar(INPUT, params);
+  ScanScalar(INPUT, params, m_scalar);
 
   // simple keys always ok after block scalars (since we're gonna start a new
   // line anyways)
   m_simpleKeyAllowed = true;
   m_canBeJSONFlow = false;
 
-  Token token(Token::NON_PLAIN_SCALAR, mark);
-  token.value = scalar;
-  m_tokens.push(token);
+  Token& token = m_tokens.push(Token::NON_PLAIN_SCALAR, mark);
+  token.value.swap(m_scalar);
 }
 }  // namespace YAML
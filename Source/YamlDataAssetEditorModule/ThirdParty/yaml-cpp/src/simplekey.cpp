@@ -72,8 +72,7 @@ void Scanner::InsertPotentialSimpleKey() {
   }
 
   // then add the (now unverified) key
-  m_tokens.push(Token(Token::KEY, INPUT.mark()));
-  key.pKey = &m_tokens.back();
+  key.pKey = &m_tokens.push(Token::KEY, INPUT.mark());
   key.pKey->status = Token::UNVERIFIED;
 
   m_simpleKeys.push(key);
@@ -1,8 +1,10 @@
 #include "singledocparser.h"
+#include <algorithm>
 #include <cstdio>
 #include <sstream>
 
 #include "collectionstack.h"  // IWYU pragma: keep
+#include "fnv1a.h"
 #include "scanner.h"
 #include "tag.h"
 #include "token.h"
@@ -14,11 +16,19 @@
 #include "yaml-cpp/include/null.h"
 
 namespace YAML {
+namespace {
+std::size_t hash_name(const std::string& name) {
+  return detail::fnv1a(name.data(), name.size());
+}
+}  // namespace
+
 SingleDocParser::SingleDocParser(Scanner& scanner, const Directives& directives)
     : m_scanner(scanner),
       m_directives(directives),
       m_pCollectionStack(new CollectionStack),
       m_anchors{},
+      m_anchorCount(0),
+      m_anchorNames{},
       m_curAnchor(0) {}
 
 SingleDocParser::~SingleDocParser() = default;
@@ -94,7 +104,7 @@ void SingleDocParser::HandleNode(EventHandler& eventHandler) {
     tag = (token.type == Token::NON_PLAIN_SCALAR ? "!" : "?");
 
   if (token.type == Token::PLAIN_SCALAR
-      && tag.compare("?") == 0 && IsNullString(token.value)) {
+      && tag.compare("?") == 0 && IsNullString(token.scalar())) {
     eventHandler.OnNull(mark, anchor);
     m_scanner.pop();
     return;
@@ -104,7 +114,7 @@ void SingleDocParser::HandleNode(EventHandler& eventHandler) {
   switch (token.type) {
     case Token::PLAIN_SCALAR:
     case Token::NON_PLAIN_SCALAR:
-      eventHandler.OnScalar(mark, tag, anchor, token.value);
+      eventHandler.OnScalarView(mark, tag, anchor, token.scalar());
       m_scanner.pop();
       return;
     case Token::FLOW_SEQ_START:
@@ -417,18 +427,67 @@ anchor_t SingleDocParser::RegisterAnchor(const std::string& name) {
   if (name.empty())
     return NullAnchor;
 
-  return m_anchors[name] = ++m_curAnchor;
+  if ((m_anchorCount + 1) * 2 > m_anchors.size())
+    GrowAnchors();
+
+  const std::size_t hash = hash_name(name);
+  AnchorSlot& slot = m_anchors[FindAnchorSlot(name, hash)];
+  if (slot.anchor == NullAnchor) {
+    slot.hash = hash;
+    slot.offset = m_anchorNames.size();
+    slot.size = name.size();
+    m_anchorNames += name;
+    m_anchorCount++;
+  }
+
+  // a name that's anchored again refers to the new node from here on
+  return slot.anchor = ++m_curAnchor;
 }
 
 anchor_t SingleDocParser::LookupAnchor(const Mark& mark,
                                        const std::string& name) const {
-  auto it = m_anchors.find(name);
-  if (it == m_anchors.end()) {
+  anchor_t anchor = NullAnchor;
+  if (!m_anchors.empty())
+    anchor = m_anchors[FindAnchorSlot(name, hash_name(name))].anchor;
+
+  if (anchor == NullAnchor) {
     std::stringstream ss;
     ss << ErrorMsg::UNKNOWN_ANCHOR << name;
     throw ParserException(mark, ss.str());
   }
 
-  return it->second;
+  return anchor;
+}
+
+// FindAnchorSlot
+// . Returns the slot with the name, or the empty slot it would go in
+std::size_t SingleDocParser::FindAnchorSlot(const std::string& name,
+                                            std::size_t hash) const {
+  const std::size_t mask = m_anchors.size() - 1;
+  std::size_t i = hash & mask;
+  for (; m_anchors[i].anchor != NullAnchor; i = (i + 1) & mask) {
+    const AnchorSlot& slot = m_anchors[i];
+    if (slot.hash == hash && slot.size == name.size() &&
+        m_anchorNames.compare(slot.offset, slot.size, name) == 0)
+      break;
+  }
+  return i;
+}
+
+void SingleDocParser::GrowAnchors() {
+  std::vector<AnchorSlot> anchors(
+      std::max<std::size_t>(m_anchors.size() * 2, 32));
+  anchors.swap(m_anchors);
+
+  const std::size_t mask = m_anchors.size() - 1;
+  for (const AnchorSlot& slot : anchors) {
+    if (slot.anchor == NullAnchor)
+      continue;
+
+    std::size_t i = slot.hash & mask;
+    while (m_anchors[i].anchor != NullAnchor)
+      i = (i + 1) & mask;
+    m_anchors[i] = slot;
+  }
 }
 }  // namespace YAML
@@ -7,9 +7,10 @@
 #pragma once
 #endif
 
-#include <map>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "yaml-cpp/include/anchor.h"
 
@@ -54,6 +55,8 @@ class SingleDocParser {
 
   anchor_t RegisterAnchor(const std::string& name);
   anchor_t LookupAnchor(const Mark& mark, const std::string& name) const;
+  std::size_t FindAnchorSlot(const std::string& name, std::size_t hash) const;
+  void GrowAnchors();
 
  private:
   int depth = 0;
@@ -61,8 +64,16 @@ class SingleDocParser {
   const Directives& m_directives;
   std::unique_ptr<CollectionStack> m_pCollectionStack;
 
-  using Anchors = std::map<std::string, anchor_t>;
-  Anchors m_anchors;
+  // anchor names, an open addressing hash table (linear probing) over the
+  // names interned back to back in m_anchorNames
+  struct AnchorSlot {
+    std::size_t hash;
+    std::size_t offset, size;  // of the name in m_anchorNames
+    anchor_t anchor;           // NullAnchor if the slot is empty
+  };
+  std::vector<AnchorSlot> m_anchors;  // a power of two, at most half full
+  std::size_t m_anchorCount;
+  std::string m_anchorNames;
 
   anchor_t m_curAnchor;
 };
@@ -158,7 +158,8 @@ inline char Utf8Adjust(unsigned long ch, unsigned char lead_bits,
       static_cast<unsigned char>(header | ((ch >> rshift) & mask)));
 }
 
-inline void QueueUnicodeCodepoint(std::deque<char>& q, unsigned long ch) {
+template <typename Queue>
+inline void QueueUnicodeCodepoint(Queue& q, unsigned long ch) {
   // We are not allowed to queue the Stream::eof() codepoint, so
   // replace it with CP_REPLACEMENT_CHARACTER
   if (static_cast<unsigned long>(Stream::eof()) == ch) {
@@ -182,21 +183,28 @@ inline void QueueUnicodeCodepoint(std::deque<char>& q, unsigned long ch) {
   }
 }
 
-Stream::Stream(std::istream& input)
-    : m_input(input),
-      m_mark{},
-      m_charSet{},
-      m_readahead{},
-      m_pPrefetched(new unsigned char[YAML_PREFETCH_SIZE]),
-      m_nPrefetchedAvailable(0),
-      m_nPrefetchedUsed(0) {
+// the intro bytes of an in-memory buffer, with the same interface as the
+// std::istream calls used to read the BOM
+struct BufferIntroSource {
   using char_traits = std::istream::traits_type;
 
-  if (!input)
-    return;
+  const char* current;
+  const char* end;
+
+  char_traits::int_type get() {
+    return current < end ? char_traits::to_int_type(*current++)
+                         : char_traits::eof();
+  }
+  void putback(char) { --current; }
+  void clear() {}
+};
+
+// Determine (or guess) the character-set by reading the BOM, if any.  See
+// the YAML specification for the determination algorithm.
+template <typename Source>
+UtfIntroState ReadIntro(Source& input) {
+  using char_traits = std::istream::traits_type;
 
-  // Determine (or guess) the character-set by reading the BOM, if any.  See
-  // the YAML specification for the determination algorithm.
   char_traits::int_type intro[4]{};
   int nIntroUsed = 0;
   UtfIntroState state = uis_start;
@@ -216,33 +224,94 @@ Stream::Stream(std::istream& input)
     state = newState;
   }
 
-  switch (state) {
-    case uis_utf8:
-      m_charSet = utf8;
-      break;
+  return state;
+}
+
+Stream::Stream(std::istream& input)
+    : m_pInput(&input),
+      m_mark{},
+      m_charSet{},
+      m_readahead{},
+      m_pPrefetched(new unsigned char[YAML_PREFETCH_SIZE]),
+      m_nPrefetchedAvailable(0),
+      m_nPrefetchedUsed(0),
+      m_pCurrent(nullptr),
+      m_pEnd(nullptr),
+      m_decoded{},
+      m_pRaw(nullptr),
+      m_pRawEnd(nullptr) {
+  if (!input)
+    return;
+
+  m_charSet = CharSetOf(ReadIntro(input));
+
+  ReadAheadTo(0);
+}
+
+Stream::Stream(const char* data, std::size_t size)
+    : m_pInput(nullptr),
+      m_mark{},
+      m_charSet{},
+      m_readahead{},
+      m_pPrefetched(nullptr),
+      m_nPrefetchedAvailable(0),
+      m_nPrefetchedUsed(0),
+      m_pCurrent(data),
+      m_pEnd(data + size),
+      m_decoded{},
+      m_pRaw(nullptr),
+      m_pRawEnd(nullptr) {
+  BufferIntroSource intro{data, data + size};
+  m_charSet = CharSetOf(ReadIntro(intro));
+  m_pCurrent = intro.current;
+
+  // utf-8 is read in place, anything else is converted up front
+  if (m_charSet != utf8) {
+    DecodeBuffer();
+  }
+}
+
+Stream::~Stream() { delete[] m_pPrefetched; }
+
+Stream::CharacterSet Stream::CharSetOf(int introState) {
+  switch (introState) {
     case uis_utf16le:
-      m_charSet = utf16le;
-      break;
+      return utf16le;
     case uis_utf16be:
-      m_charSet = utf16be;
-      break;
+      return utf16be;
     case uis_utf32le:
-      m_charSet = utf32le;
-      break;
+      return utf32le;
     case uis_utf32be:
-      m_charSet = utf32be;
-      break;
+      return utf32be;
     default:
-      m_charSet = utf8;
-      break;
+      return utf8;
   }
-
-  ReadAheadTo(0);
 }
 
-Stream::~Stream() { delete[] m_pPrefetched; }
+void Stream::DecodeBuffer() {
+  m_pRaw = reinterpret_cast<const unsigned char*>(m_pCurrent);
+  m_pRawEnd = reinterpret_cast<const unsigned char*>(m_pEnd);
+
+  while (InputGood()) {
+    if (m_charSet == utf16le || m_charSet == utf16be) {
+      StreamInUtf16();
+    } else {
+      StreamInUtf32();
+    }
+  }
+
+  m_decoded.assign(m_readahead.begin(), m_readahead.end());
+  std::deque<char>().swap(m_readahead);
+
+  m_pCurrent = m_decoded.data();
+  m_pEnd = m_pCurrent + m_decoded.size();
+}
 
 char Stream::peek() const {
+  if (!m_pInput) {
+    return m_pCurrent < m_pEnd ? *m_pCurrent : Stream::eof();
+  }
+
   if (m_readahead.empty()) {
     return Stream::eof();
   }
@@ -251,7 +320,11 @@ char Stream::peek() const {
 }
 
 Stream::operator bool() const {
-  return m_input.good() ||
+  if (!m_pInput) {
+    return m_pCurrent < m_pEnd;
+  }
+
+  return m_pInput->good() ||
          (!m_readahead.empty() && m_readahead[0] != Stream::eof());
 }
 
@@ -307,6 +380,14 @@ void Stream::eat(int n) {
 }
 
 void Stream::AdvanceCurrent() {
+  if (!m_pInput) {
+    if (m_pCurrent < m_pEnd) {
+      ++m_pCurrent;
+    }
+    m_mark.pos++;
+    return;
+  }
+
   if (!m_readahead.empty()) {
     m_readahead.pop_front();
     m_mark.pos++;
@@ -316,7 +397,7 @@ void Stream::AdvanceCurrent() {
 }
 
 bool Stream::_ReadAheadTo(size_t i) const {
-  while (m_input.good() && (m_readahead.size() <= i)) {
+  while (m_pInput->good() && (m_readahead.size() <= i)) {
     switch (m_charSet) {
       case utf8:
         StreamInUtf8();
@@ -337,15 +418,21 @@ bool Stream::_ReadAheadTo(size_t i) const {
   }
 
   // signal end of stream
-  if (!m_input.good())
+  if (!m_pInput->good())
     m_readahead.push_back(Stream::eof());
 
   return m_readahead.size() > i;
 }
 
+// InputGood
+// . Are there more bytes to read (from the istream or buffer being decoded)
+bool Stream::InputGood() const {
+  return m_pInput ? m_pInput->good() : m_pRaw != nullptr;
+}
+
 void Stream::StreamInUtf8() const {
   unsigned char b = GetNextByte();
-  if (m_input.good()) {
+  if (InputGood()) {
     m_readahead.push_back(static_cast<char>(b));
   }
 }
@@ -357,7 +444,7 @@ void Stream::StreamInUtf16() const {
 
   bytes[0] = GetNextByte();
   bytes[1] = GetNextByte();
-  if (!m_input.good()) {
+  if (!InputGood()) {
     return;
   }
   ch = (static_cast<unsigned long>(bytes[nBigEnd]) << 8) |
@@ -378,7 +465,7 @@ void Stream::StreamInUtf16() const {
     for (;;) {
       bytes[0] = GetNextByte();
       bytes[1] = GetNextByte();
-      if (!m_input.good()) {
+      if (!InputGood()) {
         QueueUnicodeCodepoint(m_readahead, CP_REPLACEMENT_CHARACTER);
         return;
       }
@@ -421,13 +508,21 @@ inline char* ReadBuffer(unsigned char* pBuffer) {
 }
 
 unsigned char Stream::GetNextByte() const {
+  if (!m_pInput) {
+    if (!m_pRaw || m_pRaw >= m_pRawEnd) {
+      m_pRaw = nullptr;
+      return 0;
+    }
+    return *m_pRaw++;
+  }
+
   if (m_nPrefetchedUsed >= m_nPrefetchedAvailable) {
-    std::streambuf* pBuf = m_input.rdbuf();
+    std::streambuf* pBuf = m_pInput->rdbuf();
     m_nPrefetchedAvailable = static_cast<std::size_t>(
         pBuf->sgetn(ReadBuffer(m_pPrefetched), YAML_PREFETCH_SIZE));
     m_nPrefetchedUsed = 0;
     if (!m_nPrefetchedAvailable) {
-      m_input.setstate(std::ios_base::eofbit);
+      m_pInput->setstate(std::ios_base::eofbit);
     }
 
     if (0 == m_nPrefetchedAvailable) {
@@ -449,7 +544,7 @@ void Stream::StreamInUtf32() const {
   bytes[1] = GetNextByte();
   bytes[2] = GetNextByte();
   bytes[3] = GetNextByte();
-  if (!m_input.good()) {
+  if (!InputGood()) {
     return;
   }
 
@@ -24,6 +24,8 @@ class Stream {
   friend class StreamCharSource;
 
   Stream(std::istream& input);
+  // reads directly from the buffer (which must outlive the stream)
+  Stream(const char* data, std::size_t size);
   Stream(const Stream&) = delete;
   Stream(Stream&&) = delete;
   Stream& operator=(const Stream&) = delete;
@@ -40,6 +42,12 @@ class Stream {
 
   static char eof() { return 0x04; }
 
+  // buffer mode only, the rest of the input so it can be scanned in bulk
+  // (nothing when reading from a std::istream)
+  const char* current() const { return m_pCurrent; }
+  std::size_t available() const;
+  void skip(std::size_t n);  // must not contain a line break
+
   const Mark mark() const { return m_mark; }
   int pos() const { return m_mark.pos; }
   int line() const { return m_mark.line; }
@@ -49,7 +57,7 @@ class Stream {
  private:
   enum CharacterSet { utf8, utf16le, utf16be, utf32le, utf32be };
 
-  std::istream& m_input;
+  std::istream* m_pInput;  // nullptr when reading from a buffer
   Mark m_mark;
 
   CharacterSet m_charSet;
@@ -59,10 +67,22 @@ class Stream {
   mutable size_t m_nPrefetchedAvailable;
   mutable size_t m_nPrefetchedUsed;
 
+  // buffer mode, the utf-8 characters still to read (either the input itself
+  // or m_decoded if it was utf-16/32)
+  const char* m_pCurrent;
+  const char* m_pEnd;
+  std::string m_decoded;
+  mutable const unsigned char* m_pRaw;  // utf-16/32 bytes still to decode
+  const unsigned char* m_pRawEnd;
+
+  static CharacterSet CharSetOf(int introState);
+
   void AdvanceCurrent();
   char CharAt(size_t i) const;
   bool ReadAheadTo(size_t i) const;
   bool _ReadAheadTo(size_t i) const;
+  bool InputGood() const;
+  void DecodeBuffer();
   void StreamInUtf8() const;
   void StreamInUtf16() const;
   void StreamInUtf32() const;
@@ -71,9 +91,27 @@ class Stream {
 
 // CharAt
 // . Unchecked access
-inline char Stream::CharAt(size_t i) const { return m_readahead[i]; }
+inline char Stream::CharAt(size_t i) const {
+  if (!m_pInput) {
+    return i < static_cast<size_t>(m_pEnd - m_pCurrent) ? m_pCurrent[i]
+                                                        : Stream::eof();
+  }
+  return m_readahead[i];
+}
+
+inline std::size_t Stream::available() const {
+  return m_pInput ? 0 : static_cast<std::size_t>(m_pEnd - m_pCurrent);
+}
+
+inline void Stream::skip(std::size_t n) {
+  m_pCurrent += n;
+  m_mark.pos += static_cast<int>(n);
+  m_mark.column += static_cast<int>(n);
+}
 
 inline bool Stream::ReadAheadTo(size_t i) const {
+  if (!m_pInput)
+    return i <= static_cast<size_t>(m_pEnd - m_pCurrent);
   if (m_readahead.size() > i)
     return true;
   return _ReadAheadTo(i);
@@ -10,6 +10,7 @@
 #include "yaml-cpp/include/mark.h"
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace YAML {
@@ -50,10 +51,27 @@ struct Token {
 
   // data
   Token(TYPE type_, const Mark& mark_)
-      : status(VALID), type(type_), mark(mark_), value{}, params{}, data(0) {}
+      : status(VALID), type(type_), mark(mark_), value{}, view{}, params{},
+        data(0) {}
+
+  // reuse for another token, the strings keep their capacity
+  void reset(TYPE type_, const Mark& mark_) {
+    status = VALID;
+    type = type_;
+    mark = mark_;
+    value.clear();
+    view = {};
+    params.clear();
+    data = 0;
+  }
+
+  // the text of a scalar, which may be a view of the input rather than value
+  std::string_view scalar() const {
+    return view.data() ? view : std::string_view(value);
+  }
 
   friend std::ostream& operator<<(std::ostream& out, const Token& token) {
-    out << TokenNames[token.type] << std::string(": ") << token.value;
+    out << TokenNames[token.type] << std::string(": ") << token.scalar();
     for (const std::string& param : token.params)
       out << std::string(" ") << param;
     return out;
@@ -63,6 +81,7 @@ struct Token {
   TYPE type;
   Mark mark;
   std::string value;
+  std::string_view view;  // scalars only, set instead of value if it can be
   std::vector<std::string> params;
   int data;
 };
@@ -0,0 +1,80 @@
+#ifndef TOKENQUEUE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define TOKENQUEUE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "token.h"
+#include "yaml-cpp/include/mark.h"
+
+namespace YAML {
+// TokenQueue
+// . A ring of tokens for the scanner. Popped tokens are kept and reset when
+//   the slot comes round again, so once it's warmed up pushing a token doesn't
+//   allocate (not even for its value, the string keeps its capacity).
+// . Tokens never move while they're queued since the scanner keeps pointers
+//   to them (simple keys, indent start tokens). If more are pending than it
+//   can hold (a long run of unverified keys) only the ring of slots grows.
+class TokenQueue {
+ public:
+  TokenQueue() : m_slots(16), m_head(0), m_size(0) {}
+
+  bool empty() const { return m_size == 0; }
+  std::size_t size() const { return m_size; }
+
+  Token& front() { return *m_slots[m_head]; }
+  const Token& front() const { return *m_slots[m_head]; }
+  Token& back() { return *m_slots[(m_head + m_size - 1) & mask()]; }
+
+  // adds a token to the end and returns it to be filled in
+  Token& push(Token::TYPE type, const Mark& mark) {
+    if (m_size == m_slots.size())
+      grow();
+
+    std::unique_ptr<Token>& slot = m_slots[(m_head + m_size) & mask()];
+    if (slot)
+      slot->reset(type, mark);
+    else
+      slot.reset(new Token(type, mark));
+
+    ++m_size;
+    return *slot;
+  }
+
+  Token& push(Token&& token) {
+    Token& slot = push(token.type, token.mark);
+    slot = std::move(token);
+    return slot;
+  }
+
+  void pop() {
+    m_head = (m_head + 1) & mask();
+    --m_size;
+  }
+
+ private:
+  std::size_t mask() const { return m_slots.size() - 1; }
+
+  // double the ring, the tokens themselves stay where they are
+  void grow() {
+    std::vector<std::unique_ptr<Token>> slots(m_slots.size() * 2);
+    for (std::size_t i = 0; i < m_size; i++)
+      slots[i] = std::move(m_slots[(m_head + i) & mask()]);
+    m_slots.swap(slots);
+    m_head = 0;
+  }
+
+  std::vector<std::unique_ptr<Token>> m_slots;  // a power of two
+  std::size_t m_head, m_size;
+};
+}  // namespace YAML
+
+#endif  // TOKENQUEUE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -21,12 +21,16 @@ public class YamlDataAssetEditorModule : ModuleRules
         PrivateIncludePaths.Add( Path.Combine( PluginDirectory, "Source/YamlDataAssetEditorModule/ThirdParty" ) );
 
         PublicDependencyModuleNames.AddRange( new string[] {
+            "AssetRegistry",
+            "ContentBrowser",
             "Core",
             "CoreUObject",
+            "DesktopPlatform",
             "Engine",
             "InputCore",
             "Slate",
             "SlateCore",
+            "ToolMenus",
             "UnrealEd",
         } );
     }